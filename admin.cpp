@@ -0,0 +1,57 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "conversation_maintenance.hpp"
+
+using namespace std;
+
+void printUsage() {
+    cout << "Usage: chatbot-admin [options] [directory]\n\n";
+    cout << "Checks every conversation in directory (default: conversations/) and reports\n";
+    cout << "corrupt files, orphaned autosaves, duplicates and stale .cbin indexes.\n";
+    cout << "Nothing is changed unless a repair option is given.\n\n";
+    cout << "Options:\n";
+    cout << "  -j <n>               Worker threads (default: 2 per CPU, at least 8)\n";
+    cout << "  --delete-corrupt     Remove files that fail to parse\n";
+    cout << "  --prune-autosaves    Remove empty or already saved autosaves and leftover temp files\n";
+    cout << "  --merge-duplicates   Remove conversations whose history is contained in another\n";
+    cout << "  --rebuild-indexes    Regenerate .cbin files that no longer match their .txt\n";
+    cout << "  --fix                All of the above\n";
+    cout << "  -h, --help           Show this help\n";
+}
+
+int main(int argc, char* argv[]) {
+    MaintenanceOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        } else if (arg == "--delete-corrupt") {
+            options.deleteCorrupt = true;
+        } else if (arg == "--prune-autosaves") {
+            options.pruneAutosaves = true;
+        } else if (arg == "--merge-duplicates") {
+            options.mergeDuplicates = true;
+        } else if (arg == "--rebuild-indexes") {
+            options.rebuildIndexes = true;
+        } else if (arg == "--fix") {
+            options.deleteCorrupt = true;
+            options.pruneAutosaves = true;
+            options.mergeDuplicates = true;
+            options.rebuildIndexes = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (arg[0] == '-') {
+            cerr << "Unknown option: " << arg << "\n";
+            printUsage();
+            return 1;
+        } else {
+            options.directory = arg;
+        }
+    }
+
+    ConversationMaintenance maintenance(options);
+    return maintenance.run();
+}
@@ -0,0 +1,116 @@
+#ifndef ANSWER_PAGER_H
+#define ANSWER_PAGER_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+// Splits an answer into screen rows for a pane of a given size. The row
+// index holds the byte offset where each wrapped row starts, so any page
+// is found in O(1) and only its rows are ever copied out. The index is
+// rebuilt only when the width changes; the page keeps its first row.
+class AnswerPager {
+private:
+    static constexpr size_t FOOTER_ROWS = 2;
+
+    string text;
+    vector<size_t> rowStarts;
+    size_t width;
+    size_t height;
+    size_t page;
+
+    // Columns are counted per UTF-8 code point, so multi-byte characters
+    // are never split across rows.
+    void buildIndex() {
+        rowStarts.clear();
+        size_t pos = 0;
+
+        do {
+            rowStarts.push_back(pos);
+            size_t columns = 0;
+            while (pos < text.size() && text[pos] != '\n' && columns < width) {
+                pos++;
+                while (pos < text.size() && ((unsigned char)text[pos] & 0xC0) == 0x80) pos++;
+                columns++;
+            }
+            if (pos < text.size() && text[pos] == '\n') pos++;
+        } while (pos < text.size());
+    }
+
+    size_t rowsPerPage() const {
+        return height > FOOTER_ROWS ? height - FOOTER_ROWS : 1;
+    }
+
+    size_t rowEnd(size_t row) const {
+        size_t end = row + 1 < rowStarts.size() ? rowStarts[row + 1] : text.size();
+        if (end > rowStarts[row] && text[end - 1] == '\n') end--;
+        return end;
+    }
+
+public:
+    AnswerPager() : width(80), height(24), page(0) {
+        buildIndex();
+    }
+
+    void setText(const string& answer) {
+        text.clear();
+        text.reserve(answer.size());
+        for (char c : answer) {
+            if (c == '\t') text += "    ";
+            else if (c != '\r') text += c;
+        }
+        page = 0;
+        buildIndex();
+    }
+
+    void setGeometry(size_t columns, size_t rows) {
+        columns = max<size_t>(columns, 1);
+        size_t anchor = rowStarts[min(page * rowsPerPage(), rowStarts.size() - 1)];
+        height = rows;
+
+        if (columns != width) {
+            width = columns;
+            buildIndex();
+        }
+
+        size_t row = upper_bound(rowStarts.begin(), rowStarts.end(), anchor) - rowStarts.begin() - 1;
+        page = row / rowsPerPage();
+    }
+
+    size_t pageCount() const {
+        return (rowStarts.size() + rowsPerPage() - 1) / rowsPerPage();
+    }
+
+    size_t currentPage() const {
+        return page;
+    }
+
+    bool seek(size_t target) {
+        if (target >= pageCount()) return false;
+        page = target;
+        return true;
+    }
+
+    // One full screen: clear, the page's rows, and a footer on the last line.
+    string render() const {
+        string frame = "\033[H\033[2J";
+        size_t first = page * rowsPerPage();
+        size_t last = min(first + rowsPerPage(), rowStarts.size());
+
+        for (size_t row = first; row < last; row++) {
+            frame.append(text, rowStarts[row], rowEnd(row) - rowStarts[row]);
+            frame += "\r\n";
+        }
+
+        string footer = "-- page " + to_string(page + 1) + "/" + to_string(pageCount()) +
+                        " -- next page | prev page | page <n> | close";
+        if (footer.size() > width) footer.resize(width);
+        frame += "\033[" + to_string(height) + ";1H\033[7m" + footer + "\033[0m";
+        return frame;
+    }
+};
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef CHAT_SESSION_H
+#define CHAT_SESSION_H
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include "chatbot.hpp"
+#include "tmux_manager.hpp"
+#include "conversation.hpp"
+#include "conversation_manager.hpp"
+#include "session_recorder.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+class LineSource {
+public:
+    virtual ~LineSource() {}
+    virtual bool readLine(string& line) = 0;
+};
+
+// Reads from the terminal and, when a recorder is attached, logs every
+// line, including answers to title and save prompts.
+class ConsoleLineSource : public LineSource {
+private:
+    istream& in;
+    SessionRecorder* recorder;
+
+public:
+    explicit ConsoleLineSource(istream& stream, SessionRecorder* rec = nullptr)
+        : in(stream), recorder(rec) {}
+
+    bool readLine(string& line) {
+        if (!getline(in, line)) return false;
+        if (recorder) recorder->record(line);
+        return true;
+    }
+};
+
+// Dispatches one line of user input against the chatbot, the answer panel
+// and the active conversation. Prompts inside a command read from the same
+// LineSource, so recorded sessions replay them faithfully.
+class ChatSession {
+private:
+    Chatbot& chatbot;
+    TmuxManager& tmux;
+    ConversationManager& conversations;
+    LineSource& input;
+    bool headless;
+
+    // The command a line of input runs. Commands with an argument go first:
+    // their free text must not be caught by the substring checks for help,
+    // clear or list question.
+    string commandOf(const string& userInput) {
+        string lower = toLower(trim(userInput));
+        
+        if (isPageCommand(lower)) return "page";
+        if (lower.find("load question") == 0) return "load question";
+        if (lower.find("load convo") == 0) return "load convo";
+        if (lower == "recent") return "recent";
+        if (isSwitchCommand(lower)) return "switch";
+        if (lower.find("search convo") == 0) return "search convo";
+        if (lower.find("export convo") == 0) return "export convo";
+        if (lower.find("import convo") == 0) return "import convo";
+        if (chatbot.isClearCommand(userInput)) return "clear";
+        if (chatbot.isHelpCommand(userInput)) return "help";
+        if (chatbot.isListQuestionCommand(userInput)) return "list question";
+        if (chatbot.isSaveCommand(userInput)) return "save";
+        if (chatbot.isExitCommand(userInput)) return "exit";
+        if (chatbot.isCloseCommand(userInput)) return "close";
+        if (chatbot.isNewConversationCommand(userInput)) return "new";
+        if (chatbot.isListCommand(userInput)) return "list convo";
+        return "question";
+    }
+
+public:
+    ChatSession(Chatbot& bot, TmuxManager& panel, ConversationManager& convs,
+                LineSource& source, bool noTerminal = false)
+        : chatbot(bot), tmux(panel), conversations(convs), input(source), headless(noTerminal) {}
+
+    // "page <n>" only; other text starting with "page" is a question.
+    static bool isPageCommand(const string& lower) {
+        if (lower == "next page" || lower == "prev page") return true;
+        if (lower.find("page ") != 0) return false;
+        string number = trim(lower.substr(5));
+        return !number.empty() && number.find_first_not_of("0123456789") == string::npos;
+    }
+
+    // Only "switch <digits>" is a command; "switch statement in c" is a question.
+    static bool isSwitchCommand(const string& lower) {
+        if (lower.find("switch ") != 0) return false;
+        string number = trim(lower.substr(7));
+        return !number.empty() && number.find_first_not_of("0123456789") == string::npos;
+    }
+
+    static void printWelcome() {
+        cout << "\n+========================================+\n";
+        cout << "|   Welcome to C++ Chatbot System!       |\n";
+        cout << "|   Powered by Tmux & System Concepts    |\n";
+        cout << "+========================================+\n\n";
+        cout << "Type 'help' to see available commands.\n";
+    }
+
+    // Returns false once the user asked to exit. ran, when given, receives
+    // the name of the command that handled the line ("question" for a
+    // question); replays bucket latencies by it.
+    bool handle(const string& userInput, string* ran = nullptr) {
+        if (userInput.empty()) return true;
+        
+        Conversation& conversation = conversations.current();
+        string kind = commandOf(userInput);
+        if (ran) *ran = kind;
+        
+        string command = toLower(trim(userInput));
+        if (kind == "page") {
+            if (!tmux.isPanelOpen()) {
+                cout << "No answer panel open.\n";
+                return true;
+            }
+            
+            bool moved;
+            if (command == "next page") {
+                moved = tmux.nextPage();
+            } else if (command == "prev page") {
+                moved = tmux.prevPage();
+            } else {
+                moved = tmux.showPage(strtoul(command.c_str() + 5, nullptr, 10));
+            }
+            
+            if (moved) {
+                cout << "Bot: Page " << tmux.currentPage() << "/" << tmux.pageCount() << " ➜\n";
+            } else if (!tmux.isPanelOpen()) {
+                cout << "No answer panel open.\n";
+            } else {
+                cout << "No such page (page " << tmux.currentPage() << " of "
+                     << tmux.pageCount() << ").\n";
+            }
+            return true;
+        }
+        
+        if (kind == "load question") {
+            string numStr = trim(userInput.substr(13));
+            try {
+                int num = stoi(numStr);
+                string question = chatbot.getQuestionByNumber(num);
+                if (!question.empty()) {
+                    cout << "Loading question: " << question << "\n";
+                    string answer = chatbot.findAnswer(question);
+                    if (!answer.empty()) {
+                        tmux.openAnswerPanel(answer);
+                        conversation.addMessage("user", question);
+                        conversation.addMessage("bot", answer);
+                        cout << "Bot: Answer displayed in side panel ➜\n";
+                    }
+                } else {
+                    cout << "Invalid question number.\n";
+                }
+            } catch (...) {
+                cout << "Usage: load question <number>\n";
+            }
+            return true;
+        }
+        
+        if (kind == "load convo") {
+            string numStr = trim(userInput.substr(10));
+            try {
+                int num = stoi(numStr);
+                string convoTitle = Conversation::getConversationByNumber(num, conversations.saveDirectory());
+                if (!convoTitle.empty()) {
+                    bool wasResident = conversations.isResident(convoTitle);
+                    if (conversations.open(convoTitle) && wasResident) {
+                        cout << "Switched to conversation: " << convoTitle << "\n";
+                    }
+                } else {
+                    cout << "Invalid conversation number.\n";
+                }
+            } catch (...) {
+                cout << "Usage: load convo <number>\n";
+            }
+            return true;
+        }
+        
+        if (kind == "recent") {
+            conversations.listRecent();
+            return true;
+        }
+        
+        if (kind == "switch") {
+            string numStr = trim(trim(userInput).substr(6));
+            try {
+                int num = stoi(numStr);
+                if (conversations.switchTo(num)) {
+                    Conversation& active = conversations.current();
+                    string title = active.getTitle();
+                    cout << "Switched to conversation: " << (title.empty() ? "(new)" : title)
+                         << " (" << active.messageCount() << " messages)\n";
+                } else {
+                    cout << "Invalid conversation number. Type 'recent' to list them.\n";
+                }
+            } catch (...) {
+                cout << "Usage: switch <number>\n";
+            }
+            return true;
+        }
+        
+        if (kind == "search convo") {
+            string term = trim(trim(userInput).substr(12));
+            if (term.empty()) {
+                cout << "Usage: search convo <text>\n";
+            } else {
+                conversation.searchConversation(term);
+            }
+            return true;
+        }
+        
+        if (kind == "export convo") {
+            string numStr = trim(userInput.substr(12));
+            try {
+                int num = stoi(numStr);
+                string convoTitle = Conversation::getConversationByNumber(num, conversations.saveDirectory());
+                if (!convoTitle.empty()) {
+                    conversation.flush();
+                    Conversation::exportConversation(convoTitle, conversations.saveDirectory());
+                } else {
+                    cout << "Invalid conversation number.\n";
+                }
+            } catch (...) {
+                cout << "Usage: export convo <number>\n";
+            }
+            return true;
+        }
+        
+        if (kind == "import convo") {
+            string convoTitle = trim(trim(userInput).substr(12));
+            if (convoTitle.empty()) {
+                cout << "Usage: import convo <title>\n";
+            } else {
+                Conversation::importConversation(convoTitle, conversations.saveDirectory());
+            }
+            return true;
+        }
+        
+        if (kind == "clear") {
+            if (!headless) {
+                system("clear");
+            }
+            printWelcome();
+            return true;
+        }
+        
+        if (kind == "help") {
+            chatbot.showHelp();
+            return true;
+        }
+        
+        if (kind == "list question") {
+            chatbot.listQuestions();
+            return true;
+        }
+        
+        if (kind == "save") {
+            if (conversation.isEmpty()) {
+                cout << "No conversation to save.\n";
+            } else {
+                string title = conversation.getTitle();
+                if (title.empty() || title.find("autosave_") == 0) {
+                    cout << "Enter conversation title (or press Enter for auto-title): ";
+                    input.readLine(title);
+                
+                    if (title.empty()) {
+                        title = "conversation_" + to_string(time(0));
+                    }
+                }
+                conversations.saveCurrent(title);
+            }
+            return true;
+        }
+        
+        conversation.addMessage("user", userInput);
+        
+        if (kind == "exit") {
+            cout << "\nSaving conversation before exit...\n";
+        
+            if (!conversation.isEmpty()) {
+                string title = conversation.getTitle();
+                if (title.empty() || title.find("autosave_") == 0) {
+                    cout << "Enter conversation title (or press Enter for auto-title): ";
+                    input.readLine(title);
+                
+                    if (title.empty()) {
+                        title = "conversation_" + to_string(time(0));
+                    }
+                }
+                conversations.saveCurrent(title);
+            }
+            
+            cout << "Goodbye!\n";
+            return false;
+        }
+        
+        if (kind == "close") {
+            tmux.closeAnswerPanel();
+            conversation.addMessage("bot", "Panel closed");
+            return true;
+        }
+        
+        if (kind == "new") {
+            if (!conversation.isEmpty()) {
+                cout << "Save current conversation? (y/n): ";
+                string save;
+                input.readLine(save);
+            
+                if (toLower(save) == "y" || toLower(save) == "yes") {
+                    string title = conversation.getTitle();
+                    if (title.empty() || title.find("autosave_") == 0) {
+                        cout << "Enter conversation title: ";
+                        input.readLine(title);
+                    
+                        if (title.empty()) {
+                            title = "conversation_" + to_string(time(0));
+                        }
+                    }
+                    conversations.saveCurrent(title);
+                }
+            }
+        
+            conversations.startNew();
+            tmux.closeAnswerPanel();
+            cout << "Started new conversation.\n";
+            return true;
+        }
+        
+        if (kind == "list convo") {
+            Conversation::listConversations(conversations.saveDirectory());
+            return true;
+        }
+        
+        string answer = chatbot.findAnswer(userInput);
+        
+        if (!answer.empty()) {
+            tmux.openAnswerPanel(answer);
+            conversation.addMessage("bot", answer);
+            cout << "Bot: Answer displayed in side panel ➜\n";
+        } else {
+            cout << "Bot: I'm sorry, I don't have an answer to that question.\n";
+            cout << "     Please try rephrasing or ask something else.\n";
+            conversation.addMessage("bot", "Answer not found");
+        }
+        
+        return true;
+    }
+};
+
+#endif
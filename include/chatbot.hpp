@@ -3,118 +3,64 @@
 
 #include <string>
 #include <map>
-#include <vector>
+#include <iostream>
+#include "knowledge_base.hpp"
 #include "utils.hpp"
 
 using namespace std;
 
 class Chatbot {
 private:
-    map<string, string> questionBank;
-    vector<string> exitCommands;
-    vector<string> closeCommands;
-    vector<string> newConversationCommands;
-    vector<string> listCommands;
-    vector<string> listQuestionCommands;
-    vector<string> saveCommands;
-    vector<string> clearCommands;
-    vector<string> helpCommands;
-
-    void initializeQuestions() {
-        
-        questionBank["what is tmux"] = 
-            "Tmux is a terminal multiplexer that allows you to create, access, and control "
-            "multiple terminals from a single screen. It's useful for managing multiple "
-            "terminal sessions.";
-        
-        questionBank["what is a process"] = 
-            "A process is an instance of a running program. It contains the program code "
-            "and its current activity. Each process has its own memory space and system resources.";
-        
-        questionBank["what is fork"] = 
-            "fork() is a system call that creates a new process by duplicating the calling "
-            "process. The new process is called the child process, and it runs concurrently "
-            "with the parent process.";
-        
-        questionBank["what is multithreading"] = 
-            "Multithreading is the ability of a CPU to execute multiple threads concurrently. "
-            "Threads are lightweight processes that share the same memory space, making "
-            "communication between them faster than inter-process communication.";
-        
-        questionBank["what are pipes"] = 
-            "Pipes are a method of inter-process communication (IPC) that allow data to flow "
-            "from one process to another. The pipe() system call creates a unidirectional "
-            "communication channel where one process writes to the pipe and another reads from it.";
-        
-        questionBank["fifo pipes"] = 
-            "FIFO (First In First Out) pipes, also called named pipes, are similar to regular "
-            "pipes but have a name in the filesystem. Unlike anonymous pipes, FIFOs can be used "
-            "by unrelated processes and persist beyond the process that created them. Created "
-            "using mkfifo() system call.";
-        
-        questionBank["shared resources"] = 
-            "Shared resources are memory regions or system resources that multiple processes or "
-            "threads can access concurrently. Common examples include shared memory segments, "
-            "files, and hardware devices. Proper synchronization mechanisms like semaphores, "
-            "mutexes, or locks are needed to prevent race conditions.";
-        
-        questionBank["what is exec"] = 
-            "The exec family of functions replaces the current process image with a new program. "
-            "Common variants include: execl(), execv(), execle(), execve(), execlp(), execvp(). "
-            "They differ in how arguments are passed (list vs array) and whether they use PATH "
-            "or environment variables. After exec, the new program runs in the same process ID.";
-        
-        questionBank["file operations"] = 
-            "File operations in Unix/Linux include: open() to open files, read() to read data, "
-            "write() to write data, close() to close files, lseek() to move file pointer, "
-            "stat() to get file information, and unlink() to delete files. File descriptors "
-            "(integers) are used to reference open files. Standard descriptors: 0=stdin, 1=stdout, 2=stderr.";
-        
-        questionBank["what are semaphores"] = 
-            "Semaphores are synchronization primitives used to control access to shared resources. "
-            "They maintain a counter: P() (wait/down) decrements it, V() (signal/up) increments it. "
-            "Binary semaphores (0 or 1) act like locks. Counting semaphores allow multiple access. "
-            "POSIX provides sem_init(), sem_wait(), sem_post(), sem_destroy(). Used to prevent race conditions.";
-        
-        questionBank["process management"] = 
-            "Process management involves creating (fork()), executing (exec()), terminating (exit()), "
-            "and monitoring processes. Key system calls: fork() creates child process, wait()/waitpid() "
-            "waits for child termination, getpid() returns process ID, getppid() returns parent ID, "
-            "kill() sends signals to processes. Process states: running, waiting, stopped, zombie.";
-    }
+    map<string, string> addedQuestions;
 
-    void initializeCommands() {
-        exitCommands = {"exit", "quit", "bye", "goodbye"};
-        closeCommands = {"close panel", "close", "hide answer"};
-        newConversationCommands = {"new conversation", "start new", "restart", "new"};
-        listCommands = {"list convo"};
-        listQuestionCommands = {"list question"};
-        saveCommands = {"save"};
-        clearCommands = {"clear"};
-        helpCommands = {"help"};
-    }
-
-    bool matchesAnyCommand(const string& input, const vector<string>& commands) {
+    // An input that is exactly a command resolves through the perfect hash;
+    // anything else falls back to the substring scan.
+    bool matchesCommand(const string& input, CommandKind kind) {
         string lowerInput = toLower(trim(input));
-        for (const auto& cmd : commands) {
-            if (lowerInput.find(cmd) != string::npos) {
+        int exact = kb::lookup(kb::COMMAND_HASH, kb::COMMANDS, &CommandEntry::text, lowerInput);
+        if (exact >= 0) {
+            return kb::COMMANDS[exact].kind == kind;
+        }
+
+        for (const auto& cmd : kb::COMMANDS) {
+            if (cmd.kind == kind && lowerInput.find(cmd.text) != string::npos) {
                 return true;
             }
         }
         return false;
     }
 
-public:
-    Chatbot() {
-        initializeQuestions();
-        initializeCommands();
+    static bool isBuiltinQuestion(const string& question) {
+        return kb::lookup(kb::QUESTION_HASH, kb::QUESTIONS, &QAEntry::question, question) >= 0;
+    }
+
+    string builtinAnswer(size_t index) {
+        if (!addedQuestions.empty()) {
+            auto it = addedQuestions.find(string(kb::QUESTIONS[index].question));
+            if (it != addedQuestions.end()) {
+                return it->second;
+            }
+        }
+        return string(kb::QUESTIONS[index].answer);
     }
 
+public:
     string findAnswer(const string& question) {
         string lowerQuestion = toLower(trim(question));
         
-        for (const auto& pair : questionBank) {
-            if (lowerQuestion.find(pair.first) != string::npos) {
+        int exact = kb::lookup(kb::QUESTION_HASH, kb::QUESTIONS, &QAEntry::question, lowerQuestion);
+        if (exact >= 0) {
+            return builtinAnswer(exact);
+        }
+        
+        for (size_t i = 0; i < kb::QUESTION_COUNT; i++) {
+            if (lowerQuestion.find(kb::QUESTIONS[i].question) != string::npos) {
+                return builtinAnswer(i);
+            }
+        }
+        
+        for (const auto& pair : addedQuestions) {
+            if (!isBuiltinQuestion(pair.first) && lowerQuestion.find(pair.first) != string::npos) {
                 return pair.second;
             }
         }
@@ -123,35 +69,35 @@ public:
     }
 
     bool isExitCommand(const string& input) {
-        return matchesAnyCommand(input, exitCommands);
+        return matchesCommand(input, CMD_EXIT);
     }
 
     bool isCloseCommand(const string& input) {
-        return matchesAnyCommand(input, closeCommands);
+        return matchesCommand(input, CMD_CLOSE);
     }
 
     bool isNewConversationCommand(const string& input) {
-        return matchesAnyCommand(input, newConversationCommands);
+        return matchesCommand(input, CMD_NEW_CONVERSATION);
     }
 
     bool isListCommand(const string& input) {
-        return matchesAnyCommand(input, listCommands);
+        return matchesCommand(input, CMD_LIST_CONVO);
     }
 
     bool isListQuestionCommand(const string& input) {
-        return matchesAnyCommand(input, listQuestionCommands);
+        return matchesCommand(input, CMD_LIST_QUESTION);
     }
 
     bool isSaveCommand(const string& input) {
-        return matchesAnyCommand(input, saveCommands);
+        return matchesCommand(input, CMD_SAVE);
     }
 
     bool isClearCommand(const string& input) {
-        return matchesAnyCommand(input, clearCommands);
+        return matchesCommand(input, CMD_CLEAR);
     }
 
     bool isHelpCommand(const string& input) {
-        return matchesAnyCommand(input, helpCommands);
+        return matchesCommand(input, CMD_HELP);
     }
 
     void showHelp() {
@@ -161,9 +107,16 @@ public:
         cout << "  load question <n>     - Load and display question by number\n";
         cout << "  list convo            - View saved conversations\n";
         cout << "  load convo <n>        - Load and continue conversation by number\n";
+        cout << "  recent                - List conversations kept in memory\n";
+        cout << "  switch <n>            - Switch to a recent conversation by number\n";
+        cout << "  search convo <text>   - Search messages in current conversation\n";
+        cout << "  export convo <n>      - Convert conversation to binary (.cbin)\n";
+        cout << "  import convo <title>  - Convert binary conversation back to text\n";
         cout << "  save                  - Save current conversation\n";
         cout << "  new                   - Start new conversation\n";
         cout << "  clear                 - Clear screen\n";
+        cout << "  next page / prev page - Page through a long answer in the panel\n";
+        cout << "  page <n>              - Jump to page n of the answer\n";
         cout << "  close                 - Close answer panel\n";
         cout << "  exit                  - Quit application\n";
         cout << "\nOr simply ask any question!\n";
@@ -172,19 +125,29 @@ public:
     void listQuestions() {
         cout << "\n=== Available Questions ===\n";
         int count = 0;
-        for (const auto& pair : questionBank) {
-            cout << ++count << ". " << pair.first << "\n";
+        for (const auto& entry : kb::QUESTIONS) {
+            cout << ++count << ". " << entry.question << "\n";
+        }
+        for (const auto& pair : addedQuestions) {
+            if (!isBuiltinQuestion(pair.first)) {
+                cout << ++count << ". " << pair.first << "\n";
+            }
         }
     }
 
+    // Built-in questions come first and are indexed directly; questions
+    // added at runtime are numbered after them.
     string getQuestionByNumber(int number) {
-        if (number < 1 || number > questionBank.size()) {
+        if (number < 1) {
             return "";
         }
+        if ((size_t)number <= kb::QUESTION_COUNT) {
+            return string(kb::QUESTIONS[number - 1].question);
+        }
         
-        int count = 0;
-        for (const auto& pair : questionBank) {
-            if (++count == number) {
+        size_t count = kb::QUESTION_COUNT;
+        for (const auto& pair : addedQuestions) {
+            if (!isBuiltinQuestion(pair.first) && ++count == (size_t)number) {
                 return pair.first;
             }
         }
@@ -192,7 +155,7 @@ public:
     }
 
     void addQuestion(const string& question, const string& answer) {
-        questionBank[toLower(question)] = answer;
+        addedQuestions[toLower(question)] = answer;
     }
 };
 
@@ -3,60 +3,233 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <memory>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <ctime>
 #include <cstdio>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <unistd.h>
 #include <mutex>
 #include <atomic>
+#include "message.hpp"
+#include "conversation_codec.hpp"
+#include "persistence_writer.hpp"
+#include "spill_segment.hpp"
 
 using namespace std;
 
-struct Message {
-    string type;
-    string content;
-    string timestamp;
-};
-
 class Conversation {
+public:
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024;
+    static constexpr const char* DEFAULT_SAVE_DIR = "conversations/";
+
 private:
-    vector<Message> messages;
+
+    deque<Message> messages;
+    vector<SpilledMessage> spilled;
+    shared_ptr<SpillSegment> spill;
+    size_t memoryBudget;
+    size_t residentBytes;
     string title;
     string filename;
-    const string SAVE_DIR = "conversations/";
+    string saveDir;
     mutable mutex conversationMutex;
     atomic<bool> isDirty;
     time_t lastSaveTime;
+    PersistenceWriter writer;
 
     string getCurrentTimestamp() {
         time_t now = time(0);
         char buf[80];
-        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
+        struct tm local;
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime_r(&now, &local));
         return string(buf);
     }
 
     void createDirectoryIfNotExists() {
         struct stat info;
-        if (stat(SAVE_DIR.c_str(), &info) != 0) {
-            mkdir(SAVE_DIR.c_str(), 0755);
+        if (stat(saveDir.c_str(), &info) != 0) {
+            mkdir(saveDir.c_str(), 0755);
         }
     }
 
+    static void writeMessageLine(ostream& out, const Message& msg) {
+        out << "[" << msg.timestamp << "] " << msg.type << ": " << msg.content << "\n\n";
+    }
+
+    static size_t messageBytes(const Message& msg) {
+        return sizeof(Message) + msg.type.size() + msg.content.size() + msg.timestamp.size();
+    }
+
+    // Oldest messages move to the spill segment until resident usage is
+    // back under three quarters of the budget; their type and timestamp
+    // stay in memory next to the segment offset. Only the offsets are
+    // reserved here: the content goes to the writer thread, which does the
+    // actual write, so addMessage never waits on the disk.
+    void spillIfNeeded() {
+        if (residentBytes <= memoryBudget || messages.size() <= 1) return;
+
+        if (!spill) spill = make_shared<SpillSegment>();
+
+        size_t target = memoryBudget / 4 * 3;
+        size_t remaining = residentBytes;
+        size_t count = 0;
+        PersistOp op;
+        op.kind = PersistOp::SPILL;
+        op.spill = spill;
+
+        while (remaining > target && count + 1 < messages.size()) {
+            remaining -= messageBytes(messages[count]);
+            op.spillData += messages[count].content;
+            count++;
+        }
+
+        uint64_t offset = spill->reserve(op.spillData.size());
+        op.spillOffset = offset;
+
+        for (size_t i = 0; i < count; i++) {
+            Message& msg = messages.front();
+            SpilledMessage entry;
+            entry.type = msg.type;
+            entry.timestamp = msg.timestamp;
+            entry.offset = offset;
+            entry.length = msg.content.size();
+            offset += entry.length;
+
+            spilled.push_back(entry);
+            messages.pop_front();
+        }
+        residentBytes = remaining;
+        writer.submit(op);
+    }
+
+    void pushResident(const Message& msg) {
+        messages.push_back(msg);
+        residentBytes += messageBytes(msg);
+        spillIfNeeded();
+    }
+
+    void resetContents() {
+        messages.clear();
+        spilled.clear();
+        spill.reset();
+        residentBytes = 0;
+    }
+
+    // Seconds alone collide when several conversations, in this process or
+    // another, start within the same second; they would share one file.
+    static string autosaveTitle() {
+        static atomic<unsigned> sequence(0);
+        return "autosave_" + to_string(time(0)) + "_" + to_string(getpid()) + "_" +
+               to_string(++sequence);
+    }
+
+    void submitOpen() {
+        PersistOp op;
+        op.kind = PersistOp::OPEN;
+        op.path = filename;
+        op.title = title;
+        writer.submit(op);
+    }
+
+    void submitRewrite(const string& removePath) {
+        PersistOp op;
+        op.kind = PersistOp::REWRITE;
+        op.path = filename;
+        op.title = title;
+        op.removePath = removePath;
+        op.spill = spill;
+        op.spilled = spilled;
+        op.snapshot.assign(messages.begin(), messages.end());
+        writer.submit(op);
+    }
+
 public:
-    Conversation() : title(""), filename(""), isDirty(false), lastSaveTime(0) {
+    // The directory ends with '/'; the statics below take the same one.
+    explicit Conversation(size_t memoryBudgetBytes = DEFAULT_MEMORY_BUDGET,
+                          const string& directory = DEFAULT_SAVE_DIR)
+        : memoryBudget(memoryBudgetBytes), residentBytes(0), title(""), filename(""),
+          saveDir(directory), isDirty(false), lastSaveTime(0) {
         createDirectoryIfNotExists();
     }
 
+    void setMemoryBudget(size_t bytes) {
+        lock_guard<mutex> lock(conversationMutex);
+        memoryBudget = bytes;
+        spillIfNeeded();
+    }
+
+    size_t memoryUsage() const {
+        lock_guard<mutex> lock(conversationMutex);
+        return residentBytes + spilled.size() * sizeof(SpilledMessage);
+    }
+
+    size_t messageCount() const {
+        lock_guard<mutex> lock(conversationMutex);
+        return spilled.size() + messages.size();
+    }
+
+    // Pages spilled messages back in from disk; resident ones are copied.
+    bool getMessage(size_t index, Message& msg) const {
+        lock_guard<mutex> lock(conversationMutex);
+        if (index < spilled.size()) {
+            return spill->load(spilled[index], msg);
+        }
+        index -= spilled.size();
+        if (index >= messages.size()) return false;
+        msg = messages[index];
+        return true;
+    }
+
+    void searchConversation(const string& term) const {
+        lock_guard<mutex> lock(conversationMutex);
+        size_t total = spilled.size() + messages.size();
+        int found = 0;
+        Message paged;
+
+        cout << "\n=== Messages matching \"" << term << "\" ===\n";
+        for (size_t i = 0; i < total; i++) {
+            const Message* msg = &paged;
+            if (i < spilled.size()) {
+                if (!spill->load(spilled[i], paged)) continue;
+            } else {
+                msg = &messages[i - spilled.size()];
+            }
+
+            if (msg->content.find(term) != string::npos) {
+                cout << i + 1 << ". [" << msg->timestamp << "] " << msg->type << ": "
+                     << msg->content << "\n";
+                found++;
+            }
+        }
+        if (found == 0) {
+            cout << "No matching messages.\n";
+        }
+    }
+
     void addMessage(const string& type, const string& content) {
         lock_guard<mutex> lock(conversationMutex);
         Message msg;
         msg.type = type;
         msg.content = content;
         msg.timestamp = getCurrentTimestamp();
-        messages.push_back(msg);
+        pushResident(msg);
         isDirty = true;
+
+        if (title.empty()) {
+            title = autosaveTitle();
+            filename = saveDir + title + ".txt";
+            submitOpen();
+        }
+
+        PersistOp op;
+        op.kind = PersistOp::APPEND;
+        op.msg = msg;
+        writer.submit(op);
     }
 
     void setTitle(const string& t) {
@@ -72,37 +245,27 @@ public:
 
     bool isEmpty() const {
         lock_guard<mutex> lock(conversationMutex);
-        return messages.empty();
+        return messages.empty() && spilled.empty();
     }
 
     void saveConversation(const string& conversationTitle) {
         lock_guard<mutex> lock(conversationMutex);
-        if (messages.empty()) return;
+        if (messages.empty() && spilled.empty()) return;
 
         string oldFilename = filename;
         string oldTitle = title;
         
         title = conversationTitle;
-        filename = SAVE_DIR + title + ".txt";
+        filename = saveDir + title + ".txt";
 
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Could not save conversation\n";
+        bool renamingAutosave = !oldFilename.empty() && oldTitle.find("autosave_") == 0;
+        submitRewrite(renamingAutosave ? oldFilename : "");
+        if (!writer.flush()) {
+            cerr << "Error: Could not save conversation (" << writer.takeError() << ")\n";
             return;
         }
 
-        file << "Title: " << title << "\n";
-        file << "Date: " << getCurrentTimestamp() << "\n";
-        file << "=====================================\n\n";
-
-        for (const auto& msg : messages) {
-            file << "[" << msg.timestamp << "] " << msg.type << ": " << msg.content << "\n\n";
-        }
-
-        file.close();
-
-        if (!oldFilename.empty() && oldTitle.find("autosave_") == 0 && oldFilename != filename) {
-            remove(oldFilename.c_str());
+        if (renamingAutosave && oldFilename != filename) {
             cout << "Conversation renamed to: " << filename << endl;
         } else {
             cout << "Conversation saved as: " << filename << endl;
@@ -114,44 +277,85 @@ public:
 
     void clear() {
         lock_guard<mutex> lock(conversationMutex);
-        messages.clear();
+        resetContents();
         title = "";
         filename = "";
         isDirty = false;
+
+        PersistOp op;
+        op.kind = PersistOp::CLOSE;
+        writer.submit(op);
+    }
+
+    bool flush() {
+        if (writer.flush()) return true;
+        cerr << "Error: " << writer.takeError() << "\n";
+        return false;
     }
 
-    static vector<string> listConversations() {
-        const string SAVE_DIR = "conversations/";
-        DIR* dir = opendir(SAVE_DIR.c_str());
-        vector<string> conversations;
+    // Saved titles in directory order: every .txt, then .cbin files that
+    // have no .txt, which load convo opens through the binary decoder.
+    static vector<string> conversationTitles(vector<bool>* binaryOnly = nullptr,
+                                             const string& saveDir = DEFAULT_SAVE_DIR) {
+        DIR* dir = opendir(saveDir.c_str());
+        vector<string> titles;
+        vector<string> binaries;
         
         if (!dir) {
-            cout << "No previous conversations found.\n";
-            return conversations;
+            return titles;
         }
 
-        cout << "\n=== Previous Conversations ===\n";
         struct dirent* entry;
-        int count = 0;
-        
         while ((entry = readdir(dir)) != nullptr) {
             string fname = entry->d_name;
             if (fname.length() > 4 && fname.substr(fname.length() - 4) == ".txt") {
-                string title = fname.substr(0, fname.length() - 4);
-                conversations.push_back(title);
-                cout << ++count << ". " << title << "\n";
+                titles.push_back(fname.substr(0, fname.length() - 4));
+            } else if (fname.length() > 5 && fname.substr(fname.length() - 5) == ".cbin") {
+                binaries.push_back(fname.substr(0, fname.length() - 5));
             }
         }
-        
         closedir(dir);
-        if (count == 0) {
+
+        size_t textCount = titles.size();
+        for (const auto& title : binaries) {
+            struct stat info;
+            if (stat((saveDir + title + ".txt").c_str(), &info) != 0) {
+                titles.push_back(title);
+            }
+        }
+        if (binaryOnly) {
+            binaryOnly->assign(titles.size(), false);
+            for (size_t i = textCount; i < titles.size(); i++) {
+                (*binaryOnly)[i] = true;
+            }
+        }
+        return titles;
+    }
+
+    static vector<string> listConversations(const string& saveDir = DEFAULT_SAVE_DIR) {
+        struct stat info;
+        if (stat(saveDir.c_str(), &info) != 0) {
+            cout << "No previous conversations found.\n";
+            return vector<string>();
+        }
+
+        vector<bool> binaryOnly;
+        vector<string> conversations = conversationTitles(&binaryOnly, saveDir);
+
+        cout << "\n=== Previous Conversations ===\n";
+        for (size_t i = 0; i < conversations.size(); i++) {
+            cout << i + 1 << ". " << conversations[i] << (binaryOnly[i] ? " (binary)" : "") << "\n";
+        }
+        
+        if (conversations.empty()) {
             cout << "No conversations found.\n";
         }
         return conversations;
     }
 
-    static void loadConversation(const string& conversationTitle) {
-        string filename = "conversations/" + conversationTitle + ".txt";
+    static void loadConversation(const string& conversationTitle,
+                                 const string& saveDir = DEFAULT_SAVE_DIR) {
+        string filename = saveDir + conversationTitle + ".txt";
         ifstream file(filename);
         
         if (!file.is_open()) {
@@ -167,130 +371,292 @@ public:
         file.close();
     }
 
-    static string getConversationByNumber(int number) {
-        const string SAVE_DIR = "conversations/";
-        DIR* dir = opendir(SAVE_DIR.c_str());
-        
-        if (!dir) {
+    static string getConversationByNumber(int number, const string& saveDir = DEFAULT_SAVE_DIR) {
+        vector<string> titles = conversationTitles(nullptr, saveDir);
+        if (number < 1 || number > (int)titles.size()) {
             return "";
         }
+        return titles[number - 1];
+    }
 
-        struct dirent* entry;
-        int count = 0;
-        string result;
-        
-        while ((entry = readdir(dir)) != nullptr) {
-            string fname = entry->d_name;
-            if (fname.length() > 4 && fname.substr(fname.length() - 4) == ".txt") {
-                if (++count == number) {
-                    result = fname.substr(0, fname.length() - 4);
-                    break;
-                }
-            }
+    static bool parseMessageLine(const string& line, Message& msg) {
+        if (line.find("[") != 0 || line.find("]") == string::npos) {
+            return false;
         }
-        
-        closedir(dir);
-        return result;
-    }
 
-    bool loadConversationIntoSession(const string& conversationTitle) {
-        string fname = SAVE_DIR + conversationTitle + ".txt";
-        ifstream file(fname);
-        
-        if (!file.is_open()) {
-            cout << "Conversation not found.\n";
+        size_t endBracket = line.find("]");
+        if (line.find(": ", endBracket) == string::npos) {
             return false;
         }
 
-        messages.clear();
-        title = conversationTitle;
-        filename = fname;
+        string typeAndContent = line.substr(endBracket + 2);
+        size_t typeEnd = typeAndContent.find(": ");
+        if (typeEnd == string::npos) {
+            return false;
+        }
 
-        cout << "\n=== Loading Conversation: " << conversationTitle << " ===\n";
-        
-        string line;
+        msg.timestamp = line.substr(1, endBracket - 1);
+        msg.type = typeAndContent.substr(0, typeEnd);
+        msg.content = typeAndContent.substr(typeEnd + 2);
+        return true;
+    }
+
+    // Splits a saved .txt file into header lines and messages. load convo,
+    // export and chatbot-admin all go through here so they accept exactly
+    // the same files. A line that is not a message line continues the
+    // message before it, blank lines included, so multi-line messages come
+    // back whole; one with no message before it is counted in malformed.
+    // Returns false if the header separator is missing.
+    template <typename HeaderFn, typename MessageFn>
+    static bool parseConversationText(const string& contents, HeaderFn onHeader,
+                                      MessageFn onMessage, size_t* malformed = nullptr) {
         bool inMessages = false;
-        
-        while (getline(file, line)) {
-            if (line.find("=====") != string::npos) {
-                inMessages = true;
-                continue;
-            }
-            
+        bool pending = false;
+        size_t blankLines = 0;
+        size_t start = 0;
+        string line;
+        Message msg;
+        Message next;
+
+        while (start < contents.size()) {
+            size_t end = contents.find('\n', start);
+            if (end == string::npos) end = contents.size();
+            line.assign(contents, start, end - start);
+            start = end + 1;
+
             if (!inMessages) {
-                cout << line << "\n";
+                if (line.find("=====") != string::npos) {
+                    inMessages = true;
+                } else {
+                    onHeader(line);
+                }
                 continue;
             }
-            
-            if (line.find("[") == 0 && line.find("]") != string::npos) {
-                size_t endBracket = line.find("]");
-                string timestamp = line.substr(1, endBracket - 1);
-                
-                size_t colonPos = line.find(": ", endBracket);
-                if (colonPos != string::npos) {
-                    string typeAndContent = line.substr(endBracket + 2);
-                    size_t typeEnd = typeAndContent.find(": ");
-                    
-                    if (typeEnd != string::npos) {
-                        string type = typeAndContent.substr(0, typeEnd);
-                        string content = typeAndContent.substr(typeEnd + 2);
-                        
-                        Message msg;
-                        msg.type = type;
-                        msg.content = content;
-                        msg.timestamp = timestamp;
-                        messages.push_back(msg);
-                        
-                        cout << "[" << timestamp << "] " << type << ": " << content << "\n";
-                    }
-                }
+
+            if (line.empty()) {
+                blankLines++;
+            } else if (parseMessageLine(line, next)) {
+                if (pending) onMessage(msg);
+                swap(msg, next);
+                pending = true;
+                blankLines = 0;
+            } else if (pending) {
+                msg.content.append(blankLines + 1, '\n');
+                msg.content += line;
+                blankLines = 0;
+            } else if (malformed) {
+                (*malformed)++;
             }
         }
-        
-        file.close();
-        cout << "\n✓ Conversation loaded. You can continue from here.\n";
+        if (pending) onMessage(msg);
+        return inMessages;
+    }
+
+    // Encodes a saved .txt file as binName, going through a temporary file.
+    static bool encodeTextFile(const string& textName, const string& binName,
+                               const string& defaultTitle, size_t& count) {
+        string contents;
+        if (!IoBackend::shared().readFile(textName, contents)) {
+            return false;
+        }
+
+        string fileTitle = defaultTitle;
+        vector<Message> parsed;
+        parseConversationText(contents,
+            [&](const string& line) {
+                if (line.find("Title: ") == 0) fileTitle = line.substr(7);
+            },
+            [&](const Message& msg) { parsed.push_back(msg); });
+
+        string tmpName = binName + ".tmp";
+        ofstream out(tmpName, ios::binary);
+        if (!out.is_open()) return false;
+
+        ConversationEncoder encoder(out);
+        bool ok = encoder.begin(fileTitle);
+        for (size_t i = 0; ok && i < parsed.size(); i++) {
+            ok = encoder.write(parsed[i]);
+        }
+        ok = ok && encoder.finish();
+        out.close();
+
+        if (!ok || !out || rename(tmpName.c_str(), binName.c_str()) != 0) {
+            remove(tmpName.c_str());
+            return false;
+        }
+
+        count = encoder.messageCount();
         return true;
     }
 
-    void autoSave() {
-        lock_guard<mutex> lock(conversationMutex);
-        
-        if (!isDirty || messages.empty()) {
-            return;
+    static bool exportConversation(const string& conversationTitle,
+                                   const string& saveDir = DEFAULT_SAVE_DIR) {
+        string textName = saveDir + conversationTitle + ".txt";
+        string binName = saveDir + conversationTitle + ".cbin";
+
+        struct stat info;
+        if (stat(textName.c_str(), &info) != 0) {
+            cout << "Conversation not found.\n";
+            return false;
+        }
+
+        size_t count = 0;
+        if (!encodeTextFile(textName, binName, conversationTitle, count)) {
+            cerr << "Error: Could not export conversation\n";
+            return false;
+        }
+
+        cout << "Exported " << count << " messages to: " << binName << endl;
+        return true;
+    }
+
+    // Decodes binName back into a .txt at textName, going through a
+    // temporary file; an existing textName is replaced. error is left empty
+    // when the failure was writing rather than decoding.
+    static bool decodeBinaryFile(const string& binName, const string& textName,
+                                 size_t& count, string& error) {
+        ifstream in(binName, ios::binary);
+        if (!in.is_open()) {
+            error = "could not open " + binName;
+            return false;
+        }
+
+        ConversationDecoder decoder(in);
+        string fileTitle;
+        if (!decoder.begin(fileTitle)) {
+            error = decoder.error();
+            return false;
+        }
+
+        string tmpName = textName + ".tmp";
+        ofstream out(tmpName);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        time_t now = time(0);
+        out << "Title: " << fileTitle << "\n";
+        out << "Date: " << cbin::formatTimestamp(now) << "\n";
+        out << "=====================================\n\n";
+
+        Message msg;
+        count = 0;
+        while (decoder.next(msg)) {
+            writeMessageLine(out, msg);
+            count++;
+        }
+        out.close();
+
+        if (!decoder.ok() || !out || rename(tmpName.c_str(), textName.c_str()) != 0) {
+            remove(tmpName.c_str());
+            if (!decoder.ok()) error = decoder.error();
+            return false;
         }
+        return true;
+    }
 
-        string saveTitle = title;
-        if (saveTitle.empty()) {
-            saveTitle = "autosave_" + to_string(time(0));
-            title = saveTitle;
+    static bool importConversation(const string& conversationTitle,
+                                   const string& saveDir = DEFAULT_SAVE_DIR) {
+        string binName = saveDir + conversationTitle + ".cbin";
+        string textName = saveDir + conversationTitle + ".txt";
+
+        struct stat info;
+        if (stat(binName.c_str(), &info) != 0) {
+            cout << "Binary conversation not found: " << binName << "\n";
+            return false;
         }
 
-        filename = SAVE_DIR + saveTitle + ".txt";
-        ofstream file(filename);
+        if (stat(textName.c_str(), &info) == 0) {
+            cout << "Conversation already exists as: " << textName << "\n";
+            return false;
+        }
+
+        size_t count = 0;
+        string error;
+        if (!decodeBinaryFile(binName, textName, count, error)) {
+            cerr << "Error: Could not import conversation"
+                 << (error.empty() ? "" : ": " + error) << "\n";
+            return false;
+        }
+
+        cout << "Imported " << count << " messages to: " << textName << endl;
+        return true;
+    }
+
+    bool loadBinaryIntoSession(const string& conversationTitle) {
+        string binName = saveDir + conversationTitle + ".cbin";
+        ifstream file(binName, ios::binary);
+
         if (!file.is_open()) {
-            return;
+            cout << "Conversation not found.\n";
+            return false;
         }
 
-        file << "Title: " << saveTitle << "\n";
-        file << "Date: " << getCurrentTimestamp() << "\n";
-        file << "=====================================\n\n";
+        ConversationDecoder decoder(file);
+        string fileTitle;
+        if (!decoder.begin(fileTitle)) {
+            cerr << "Error: Could not load " << binName << ": " << decoder.error() << "\n";
+            return false;
+        }
 
-        for (const auto& msg : messages) {
-            file << "[" << msg.timestamp << "] " << msg.type << ": " << msg.content << "\n\n";
+        lock_guard<mutex> lock(conversationMutex);
+        resetContents();
+
+        cout << "\n=== Loading Conversation: " << conversationTitle << " ===\n";
+        cout << "Title: " << fileTitle << "\n";
+
+        Message msg;
+        while (decoder.next(msg)) {
+            pushResident(msg);
+            cout << "[" << msg.timestamp << "] " << msg.type << ": " << msg.content << "\n";
+        }
+        if (!decoder.ok()) {
+            cerr << "Error: Could not load " << binName << ": " << decoder.error() << "\n";
+            resetContents();
+            title = "";
+            filename = "";
+            return false;
         }
 
-        file.close();
+        title = conversationTitle;
+        filename = saveDir + conversationTitle + ".txt";
         isDirty = false;
-        lastSaveTime = time(0);
+        submitRewrite("");
+        cout << "\n✓ Conversation loaded. You can continue from here.\n";
+        return true;
     }
 
-    bool needsAutoSave() const {
-        return isDirty.load() && !messages.empty();
-    }
+    bool loadConversationIntoSession(const string& conversationTitle) {
+        string fname = saveDir + conversationTitle + ".txt";
+        string contents;
+        
+        if (!IoBackend::shared().readFile(fname, contents)) {
+            struct stat info;
+            if (stat(fname.c_str(), &info) == 0) {
+                cerr << "Error: Could not read " << fname << "\n";
+                return false;
+            }
+            return loadBinaryIntoSession(conversationTitle);
+        }
 
-    bool hasTitleForAutoSave() const {
         lock_guard<mutex> lock(conversationMutex);
-        return !title.empty();
+        resetContents();
+        title = conversationTitle;
+        filename = fname;
+        isDirty = false;
+
+        cout << "\n=== Loading Conversation: " << conversationTitle << " ===\n";
+        
+        parseConversationText(contents,
+            [](const string& line) { cout << line << "\n"; },
+            [this](const Message& msg) {
+                pushResident(msg);
+                cout << "[" << msg.timestamp << "] " << msg.type << ": " << msg.content << "\n";
+            });
+        
+        submitOpen();
+        cout << "\n✓ Conversation loaded. You can continue from here.\n";
+        return true;
     }
 };
 
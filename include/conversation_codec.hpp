@@ -0,0 +1,408 @@
+#ifndef CONVERSATION_CODEC_H
+#define CONVERSATION_CODEC_H
+
+#include <string>
+#include <iostream>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include "message.hpp"
+
+#ifndef CHATBOT_NO_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace std;
+
+// Binary conversation format (.cbin):
+//
+//   header  : "CHBC" | u8 version | u8 flags | varint titleLen | title
+//   block   : u8 codec | varint rawLen | varint storedLen | u32 crc32(raw) | payload
+//   trailer : u8 0xFF | varint messageCount
+//
+// A block payload is a run of records:
+//
+//   u8 role | zigzag varint timestamp delta | varint len | content
+//
+// Role 0 is "user", 1 is "bot"; ROLE_CUSTOM is followed by the type string.
+// Timestamps are the wall-clock fields counted as seconds in UTC (timegm),
+// so a file decodes the same in every timezone. ROLE_RAW_TIME replaces the
+// delta with the literal timestamp string for text that does not parse.
+
+namespace cbin {
+
+const char MAGIC[4] = {'C', 'H', 'B', 'C'};
+const uint8_t VERSION = 1;
+const uint8_t CODEC_STORED = 0;
+const uint8_t CODEC_ZLIB = 1;
+const uint8_t END_OF_STREAM = 0xFF;
+const uint8_t ROLE_USER = 0;
+const uint8_t ROLE_BOT = 1;
+const uint8_t ROLE_CUSTOM = 0x7F;
+const uint8_t ROLE_RAW_TIME = 0x80;
+const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+const uint64_t MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+// The table is built once by a thread-safe static initializer; the codec
+// runs on many threads at once in chatbot-admin.
+inline uint32_t crc32(const char* data, size_t len) {
+#ifndef CHATBOT_NO_ZLIB
+    return (uint32_t)::crc32(0L, (const Bytef*)data, (uInt)len);
+#else
+    struct Table {
+        uint32_t entries[256];
+    };
+    static const Table table = [] {
+        Table t;
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t.entries[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc = table.entries[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+#endif
+}
+
+inline void putVarint(string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+inline bool getVarint(const string& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        unsigned char b = in[pos++];
+        value |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline bool readVarint(istream& in, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if (c == EOF) return false;
+        value |= (uint64_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+inline string formatTimestamp(time_t t) {
+    char buf[80];
+    struct tm local;
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime_r(&t, &local));
+    return string(buf);
+}
+
+inline string formatWallClock(time_t t) {
+    char buf[80];
+    struct tm fields;
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", gmtime_r(&t, &fields));
+    return string(buf);
+}
+
+// Independent of TZ: the fields are counted as if they were UTC.
+inline bool parseTimestamp(const string& ts, int64_t& out) {
+    struct tm tmv;
+    memset(&tmv, 0, sizeof(tmv));
+    const char* end = strptime(ts.c_str(), "%Y-%m-%d %H:%M:%S", &tmv);
+    if (!end || *end) return false;
+
+    time_t t = timegm(&tmv);
+    if (t == (time_t)-1 || formatWallClock(t) != ts) return false;
+
+    out = (int64_t)t;
+    return true;
+}
+
+}
+
+class ConversationEncoder {
+private:
+    ostream& out;
+    size_t blockSize;
+    string block;
+    int64_t lastTime;
+    string lastTimestamp;
+    uint64_t count;
+    bool failed;
+
+    bool flushBlock() {
+        if (block.empty()) return !failed;
+
+        string header;
+        string payload;
+        uint8_t codec = cbin::CODEC_STORED;
+        uint32_t crc = cbin::crc32(block.data(), block.size());
+        size_t rawLen = block.size();
+
+#ifndef CHATBOT_NO_ZLIB
+        uLongf packedLen = compressBound(block.size());
+        payload.resize(packedLen);
+        if (compress2((Bytef*)&payload[0], &packedLen, (const Bytef*)block.data(),
+                      block.size(), Z_DEFAULT_COMPRESSION) == Z_OK && packedLen < block.size()) {
+            payload.resize(packedLen);
+            codec = cbin::CODEC_ZLIB;
+        }
+#endif
+        if (codec == cbin::CODEC_STORED) {
+            payload.swap(block);
+        }
+
+        header += (char)codec;
+        cbin::putVarint(header, rawLen);
+        cbin::putVarint(header, payload.size());
+        for (int i = 0; i < 4; i++) {
+            header += (char)((crc >> (8 * i)) & 0xFF);
+        }
+
+        out.write(header.data(), header.size());
+        out.write(payload.data(), payload.size());
+        block.clear();
+
+        if (!out) failed = true;
+        return !failed;
+    }
+
+public:
+    explicit ConversationEncoder(ostream& stream, size_t blockBytes = cbin::DEFAULT_BLOCK_SIZE)
+        : out(stream), blockSize(blockBytes), lastTime(0), count(0), failed(false) {}
+
+    bool begin(const string& title) {
+        string header(cbin::MAGIC, sizeof(cbin::MAGIC));
+        header += (char)cbin::VERSION;
+        header += (char)0;
+        cbin::putVarint(header, title.size());
+        header += title;
+
+        out.write(header.data(), header.size());
+        if (!out) failed = true;
+        return !failed;
+    }
+
+    bool write(const Message& msg) {
+        if (failed) return false;
+
+        uint8_t role = cbin::ROLE_CUSTOM;
+        if (msg.type == "user") role = cbin::ROLE_USER;
+        else if (msg.type == "bot") role = cbin::ROLE_BOT;
+
+        int64_t t = lastTime;
+        bool exactTime = (!lastTimestamp.empty() && msg.timestamp == lastTimestamp) ||
+                         cbin::parseTimestamp(msg.timestamp, t);
+        if (!exactTime) role |= cbin::ROLE_RAW_TIME;
+
+        block += (char)role;
+        if ((role & ~cbin::ROLE_RAW_TIME) == cbin::ROLE_CUSTOM) {
+            cbin::putVarint(block, msg.type.size());
+            block += msg.type;
+        }
+        if (exactTime) {
+            cbin::putVarint(block, cbin::zigzag(t - lastTime));
+            lastTime = t;
+            lastTimestamp = msg.timestamp;
+        } else {
+            cbin::putVarint(block, msg.timestamp.size());
+            block += msg.timestamp;
+        }
+        cbin::putVarint(block, msg.content.size());
+        block += msg.content;
+        count++;
+
+        if (block.size() >= blockSize) {
+            return flushBlock();
+        }
+        return true;
+    }
+
+    bool finish() {
+        if (!flushBlock()) return false;
+
+        string trailer;
+        trailer += (char)cbin::END_OF_STREAM;
+        cbin::putVarint(trailer, count);
+        out.write(trailer.data(), trailer.size());
+        out.flush();
+
+        if (!out) failed = true;
+        return !failed;
+    }
+
+    uint64_t messageCount() const {
+        return count;
+    }
+};
+
+class ConversationDecoder {
+private:
+    istream& in;
+    string block;
+    size_t pos;
+    int64_t lastTime;
+    int64_t formattedTime;
+    string formatted;
+    uint64_t count;
+    bool finished;
+    string errorMessage;
+
+    bool fail(const string& reason) {
+        if (errorMessage.empty()) errorMessage = reason;
+        return false;
+    }
+
+    bool loadBlock() {
+        int codec = in.get();
+        if (codec == EOF) return fail("truncated stream");
+
+        if (codec == cbin::END_OF_STREAM) {
+            uint64_t expected;
+            if (!cbin::readVarint(in, expected)) return fail("truncated trailer");
+            if (expected != count) return fail("message count mismatch");
+            finished = true;
+            return false;
+        }
+
+        uint64_t rawLen, storedLen;
+        if (!cbin::readVarint(in, rawLen) || !cbin::readVarint(in, storedLen)) {
+            return fail("truncated block header");
+        }
+        if (rawLen > cbin::MAX_BLOCK_SIZE || storedLen > cbin::MAX_BLOCK_SIZE) {
+            return fail("block too large");
+        }
+
+        unsigned char crcBytes[4];
+        if (!in.read((char*)crcBytes, 4)) return fail("truncated block header");
+        uint32_t crc = crcBytes[0] | (crcBytes[1] << 8) | (crcBytes[2] << 16) |
+                       ((uint32_t)crcBytes[3] << 24);
+
+        string payload(storedLen, '\0');
+        if (storedLen > 0 && !in.read(&payload[0], storedLen)) return fail("truncated block");
+
+        if (codec == cbin::CODEC_STORED) {
+            if (storedLen != rawLen) return fail("corrupt block length");
+            block.swap(payload);
+        } else if (codec == cbin::CODEC_ZLIB) {
+#ifndef CHATBOT_NO_ZLIB
+            block.assign(rawLen, '\0');
+            uLongf outLen = rawLen;
+            if (uncompress((Bytef*)&block[0], &outLen, (const Bytef*)payload.data(),
+                           storedLen) != Z_OK || outLen != rawLen) {
+                return fail("corrupt compressed block");
+            }
+#else
+            return fail("zlib support not compiled in");
+#endif
+        } else {
+            return fail("unknown block codec");
+        }
+
+        if (cbin::crc32(block.data(), block.size()) != crc) return fail("checksum mismatch");
+        pos = 0;
+        return true;
+    }
+
+public:
+    explicit ConversationDecoder(istream& stream)
+        : in(stream), pos(0), lastTime(0), formattedTime(-1), count(0), finished(false) {}
+
+    bool begin(string& title) {
+        char magic[4];
+        if (!in.read(magic, 4) || memcmp(magic, cbin::MAGIC, 4) != 0) {
+            return fail("not a binary conversation file");
+        }
+
+        int version = in.get();
+        int flags = in.get();
+        if (version != cbin::VERSION || flags == EOF) return fail("unsupported version");
+
+        uint64_t titleLen;
+        if (!cbin::readVarint(in, titleLen) || titleLen > cbin::MAX_BLOCK_SIZE) {
+            return fail("corrupt header");
+        }
+        title.assign(titleLen, '\0');
+        if (titleLen > 0 && !in.read(&title[0], titleLen)) return fail("corrupt header");
+        return true;
+    }
+
+    bool next(Message& msg) {
+        while (pos >= block.size()) {
+            if (finished || !errorMessage.empty() || !loadBlock()) return false;
+        }
+
+        uint8_t role = block[pos++];
+        bool rawTime = role & cbin::ROLE_RAW_TIME;
+        role &= ~cbin::ROLE_RAW_TIME;
+
+        uint64_t len;
+        if (role == cbin::ROLE_USER) {
+            msg.type = "user";
+        } else if (role == cbin::ROLE_BOT) {
+            msg.type = "bot";
+        } else if (role == cbin::ROLE_CUSTOM) {
+            if (!cbin::getVarint(block, pos, len) || len > block.size() - pos) {
+                return fail("corrupt record");
+            }
+            msg.type = block.substr(pos, len);
+            pos += len;
+        } else {
+            return fail("unknown role");
+        }
+
+        if (rawTime) {
+            if (!cbin::getVarint(block, pos, len) || len > block.size() - pos) {
+                return fail("corrupt record");
+            }
+            msg.timestamp = block.substr(pos, len);
+            pos += len;
+        } else {
+            uint64_t delta;
+            if (!cbin::getVarint(block, pos, delta)) return fail("corrupt record");
+            lastTime += cbin::unzigzag(delta);
+            if (lastTime != formattedTime) {
+                formatted = cbin::formatWallClock((time_t)lastTime);
+                formattedTime = lastTime;
+            }
+            msg.timestamp = formatted;
+        }
+
+        if (!cbin::getVarint(block, pos, len) || len > block.size() - pos) {
+            return fail("corrupt record");
+        }
+        msg.content = block.substr(pos, len);
+        pos += len;
+        count++;
+        return true;
+    }
+
+    bool ok() const {
+        return errorMessage.empty();
+    }
+
+    const string& error() const {
+        return errorMessage;
+    }
+};
+
+#endif
@@ -0,0 +1,528 @@
+#ifndef CONVERSATION_MAINTENANCE_H
+#define CONVERSATION_MAINTENANCE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <ctime>
+#include <cstdint>
+#include <cstdio>
+#include <cctype>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "conversation.hpp"
+#include "work_stealing_pool.hpp"
+
+using namespace std;
+
+struct MaintenanceOptions {
+    string directory;
+    unsigned threads;
+    bool deleteCorrupt;
+    bool pruneAutosaves;
+    bool mergeDuplicates;
+    bool rebuildIndexes;
+
+    MaintenanceOptions()
+        : directory("conversations/"), threads(0), deleteCorrupt(false),
+          pruneAutosaves(false), mergeDuplicates(false), rebuildIndexes(false) {}
+};
+
+struct ScannedFile {
+    enum Kind { TEXT, BINARY, LEFTOVER };
+
+    string name;
+    Kind kind;
+    bool corrupt;
+    string problem;
+    size_t messages;
+    uint64_t firstHash;
+    uint64_t fullHash;
+};
+
+// Bulk checks over a conversations directory for chatbot-admin. Every
+// file is parsed with the same code load convo uses, on a work-stealing
+// pool: directory walks, file batches, duplicate groups and repairs are
+// all tasks, so one slow directory or large file never idles the rest.
+class ConversationMaintenance {
+private:
+    static constexpr size_t BATCH_SIZE = 256;
+    static constexpr time_t ACTIVE_SECONDS = 600;
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    struct Finding {
+        enum Kind { CORRUPT, ORPHANED_AUTOSAVE, DUPLICATE, STALE_INDEX, LEFTOVER_TEMP };
+
+        Kind kind;
+        string name;
+        string detail;
+        bool restorable;
+    };
+
+    MaintenanceOptions options;
+    WorkStealingPool pool;
+
+    mutex resultsMutex;
+    vector<ScannedFile> files;
+    vector<Finding> findings;
+    vector<string> notes;
+
+    atomic<size_t> bytesRead;
+    atomic<size_t> removed;
+    atomic<size_t> rebuilt;
+    atomic<size_t> restored;
+    atomic<size_t> failed;
+
+    static uint64_t hashBytes(uint64_t h, const string& data) {
+        for (unsigned char c : data) {
+            h = (h ^ c) * FNV_PRIME;
+        }
+        return (h ^ 0xFF) * FNV_PRIME;
+    }
+
+    static uint64_t hashMessage(uint64_t h, const Message& msg) {
+        h = hashBytes(h, msg.type);
+        h = hashBytes(h, msg.timestamp);
+        return hashBytes(h, msg.content);
+    }
+
+    static bool endsWith(const string& value, const string& suffix) {
+        return value.size() >= suffix.size() &&
+               value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    static string titleOf(const ScannedFile& file) {
+        size_t dot = file.name.rfind('.');
+        return file.name.substr(0, dot);
+    }
+
+    static bool isAutosave(const string& title) {
+        size_t slash = title.rfind('/');
+        return title.compare(slash == string::npos ? 0 : slash + 1, 9, "autosave_") == 0;
+    }
+
+    // Temporary files from a rewrite or export that died before its rename:
+    // <title>.txt.XXXXXX from mkstemp, or <title>.{txt,cbin}.tmp. Titles are
+    // free text, so nothing else with ".txt." in its name qualifies.
+    static bool isLeftoverTemp(const string& name) {
+        if (endsWith(name, ".txt.tmp") || endsWith(name, ".cbin.tmp")) return true;
+
+        const size_t suffix = 6;
+        if (name.size() < suffix + 5 || name.compare(name.size() - suffix - 5, 5, ".txt.") != 0) {
+            return false;
+        }
+        for (size_t i = name.size() - suffix; i < name.size(); i++) {
+            if (!isalnum((unsigned char)name[i])) return false;
+        }
+        return true;
+    }
+
+    string pathOf(const string& name) const {
+        return options.directory + name;
+    }
+
+    // Files touched recently may still belong to a running session.
+    bool recentlyModified(const string& name) const {
+        struct stat info;
+        if (stat(pathOf(name).c_str(), &info) != 0) return false;
+        return time(0) - info.st_mtime < ACTIVE_SECONDS;
+    }
+
+    void note(const string& line) {
+        lock_guard<mutex> lock(resultsMutex);
+        notes.push_back(line);
+    }
+
+    void addFinding(Finding::Kind kind, const string& name, const string& detail,
+                    bool restorable = false) {
+        lock_guard<mutex> lock(resultsMutex);
+        findings.push_back({kind, name, detail, restorable});
+    }
+
+    // Text files read like load convo reads them; cumulative, when given,
+    // receives the running hash after each message.
+    bool scanText(ScannedFile& file, vector<uint64_t>* cumulative = nullptr) {
+        string contents;
+        if (!IoBackend::shared().readFile(pathOf(file.name), contents)) {
+            file.problem = "unreadable";
+            return false;
+        }
+        bytesRead += contents.size();
+
+        size_t malformed = 0;
+        uint64_t hash = FNV_OFFSET;
+        bool hasHeader = Conversation::parseConversationText(contents,
+            [](const string&) {},
+            [&](const Message& msg) {
+                hash = hashMessage(hash, msg);
+                if (file.messages++ == 0) file.firstHash = hashMessage(FNV_OFFSET, msg);
+                if (cumulative) cumulative->push_back(hash);
+            },
+            &malformed);
+        file.fullHash = hash;
+
+        if (!hasHeader) {
+            file.problem = "missing header";
+        } else if (malformed > 0) {
+            note("warning: " + file.name + " has " + to_string(malformed) + " line" +
+                 (malformed == 1 ? "" : "s") + " before its first message, ignored");
+        }
+        return file.problem.empty();
+    }
+
+    bool scanBinary(ScannedFile& file) {
+        ifstream in(pathOf(file.name), ios::binary);
+        if (!in.is_open()) {
+            file.problem = "unreadable";
+            return false;
+        }
+
+        ConversationDecoder decoder(in);
+        string fileTitle;
+        uint64_t hash = FNV_OFFSET;
+        Message msg;
+
+        if (decoder.begin(fileTitle)) {
+            while (decoder.next(msg)) {
+                hash = hashMessage(hash, msg);
+                file.messages++;
+            }
+        }
+        file.fullHash = hash;
+        in.clear();
+        in.seekg(0, ios::end);
+        if (in.tellg() > 0) bytesRead += (size_t)in.tellg();
+
+        if (!decoder.ok()) {
+            file.problem = decoder.error();
+            return false;
+        }
+        return true;
+    }
+
+    void scanBatch(const vector<ScannedFile>& batch) {
+        vector<ScannedFile> scanned(batch);
+        for (auto& file : scanned) {
+            if (file.kind == ScannedFile::TEXT) {
+                file.corrupt = !scanText(file);
+            } else if (file.kind == ScannedFile::BINARY) {
+                file.corrupt = !scanBinary(file);
+            }
+        }
+
+        lock_guard<mutex> lock(resultsMutex);
+        files.insert(files.end(), scanned.begin(), scanned.end());
+    }
+
+    void walk(const string& relative) {
+        DIR* dir = opendir(pathOf(relative).c_str());
+        if (!dir) {
+            note("cannot open directory " + pathOf(relative));
+            return;
+        }
+
+        vector<ScannedFile> batch;
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            string name = entry->d_name;
+            if (name == "." || name == "..") continue;
+            name = relative + name;
+
+            bool isDir = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                struct stat info;
+                isDir = stat(pathOf(name).c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+            }
+            if (isDir) {
+                pool.submit([this, name] { walk(name + "/"); });
+                continue;
+            }
+
+            ScannedFile file = {name, ScannedFile::TEXT, false, "", 0, 0, 0};
+            if (isLeftoverTemp(name)) {
+                file.kind = ScannedFile::LEFTOVER;
+            } else if (endsWith(name, ".cbin")) {
+                file.kind = ScannedFile::BINARY;
+            } else if (!endsWith(name, ".txt")) {
+                continue;
+            }
+
+            batch.push_back(file);
+            if (batch.size() == BATCH_SIZE) {
+                pool.submit([this, batch] { scanBatch(batch); });
+                batch.clear();
+            }
+        }
+        closedir(dir);
+
+        if (!batch.empty()) {
+            pool.submit([this, batch] { scanBatch(batch); });
+        }
+    }
+
+    // Members share their first message. Longest first, a titled copy ahead
+    // of an autosave, so each file is compared against the keepers before it
+    // and dropped when its whole history is a prefix of one of them.
+    void checkGroup(vector<const ScannedFile*> group) {
+        sort(group.begin(), group.end(), [](const ScannedFile* a, const ScannedFile* b) {
+            if (a->messages != b->messages) return a->messages > b->messages;
+            bool autoA = isAutosave(titleOf(*a));
+            bool autoB = isAutosave(titleOf(*b));
+            if (autoA != autoB) return autoB;
+            return a->name < b->name;
+        });
+
+        vector<vector<uint64_t>> hashes(group.size());
+        vector<size_t> keepers;
+
+        for (size_t i = 0; i < group.size(); i++) {
+            ScannedFile rescan = {group[i]->name, ScannedFile::TEXT, false, "", 0, 0, 0};
+            if (!scanText(rescan, &hashes[i]) || rescan.fullHash != group[i]->fullHash) {
+                continue;
+            }
+
+            size_t length = hashes[i].size();
+            const ScannedFile* container = nullptr;
+            for (size_t k : keepers) {
+                if (hashes[k].size() >= length && hashes[k][length - 1] == hashes[i][length - 1]) {
+                    container = group[k];
+                    break;
+                }
+            }
+
+            if (!container) {
+                keepers.push_back(i);
+                continue;
+            }
+
+            string title = titleOf(*group[i]);
+            string other = titleOf(*container);
+            if (isAutosave(title)) {
+                addFinding(Finding::ORPHANED_AUTOSAVE, group[i]->name, "already saved as " + other);
+            } else {
+                addFinding(Finding::DUPLICATE, group[i]->name,
+                           (container->messages == group[i]->messages ? "identical to "
+                                                                      : "contained in ") + other);
+            }
+            hashes[i].clear();
+        }
+    }
+
+    void analyze() {
+        unordered_map<string, const ScannedFile*> texts;
+        unordered_map<string, const ScannedFile*> binaries;
+        unordered_map<uint64_t, vector<const ScannedFile*>> groups;
+
+        for (const auto& file : files) {
+            if (file.kind == ScannedFile::TEXT) {
+                texts[titleOf(file)] = &file;
+            } else if (file.kind == ScannedFile::BINARY) {
+                binaries[titleOf(file)] = &file;
+            }
+        }
+
+        for (const auto& file : files) {
+            string title = titleOf(file);
+
+            if (file.kind == ScannedFile::LEFTOVER) {
+                addFinding(Finding::LEFTOVER_TEMP, file.name, "interrupted write");
+            } else if (file.kind == ScannedFile::BINARY) {
+                auto text = texts.find(title);
+                if (text == texts.end() || text->second->corrupt) {
+                    if (file.corrupt) addFinding(Finding::CORRUPT, file.name, file.problem);
+                } else if (file.corrupt) {
+                    addFinding(Finding::STALE_INDEX, file.name, file.problem);
+                } else if (file.messages != text->second->messages ||
+                           file.fullHash != text->second->fullHash) {
+                    addFinding(Finding::STALE_INDEX, file.name, "out of date with " + text->second->name);
+                }
+            } else if (file.corrupt) {
+                // The .cbin is then the surviving copy; the text is rebuilt from it.
+                auto binary = binaries.find(title);
+                if (binary != binaries.end() && !binary->second->corrupt) {
+                    addFinding(Finding::CORRUPT, file.name,
+                               file.problem + ", restorable from " + binary->second->name, true);
+                } else {
+                    addFinding(Finding::CORRUPT, file.name, file.problem);
+                }
+            } else if (file.messages == 0) {
+                if (isAutosave(title)) addFinding(Finding::ORPHANED_AUTOSAVE, file.name, "no messages");
+            } else {
+                groups[file.firstHash].push_back(&file);
+            }
+        }
+
+        for (auto& group : groups) {
+            if (group.second.size() > 1) {
+                vector<const ScannedFile*> members = group.second;
+                pool.submit([this, members] { checkGroup(members); });
+            }
+        }
+        pool.wait();
+    }
+
+    bool skipIfActive(const string& name) {
+        if (!recentlyModified(name)) return false;
+        note("skipped " + name + " (modified in the last " + to_string(ACTIVE_SECONDS / 60) +
+             " minutes, may belong to a running session)");
+        return true;
+    }
+
+    // withIndex also removes a .txt's .cbin, which is only right when the
+    // conversation itself goes away, not when the .txt is merely corrupt.
+    void removeFile(const string& name, bool withIndex) {
+        if (skipIfActive(name)) return;
+
+        if (remove(pathOf(name).c_str()) != 0) {
+            note("could not remove " + name);
+            failed++;
+            return;
+        }
+        removed++;
+
+        if (withIndex && endsWith(name, ".txt")) {
+            string index = pathOf(name.substr(0, name.size() - 4) + ".cbin");
+            if (remove(index.c_str()) == 0) removed++;
+        }
+    }
+
+    void rebuildIndex(const string& name) {
+        string title = name.substr(0, name.size() - 5);
+        size_t count = 0;
+        if (Conversation::encodeTextFile(pathOf(title + ".txt"), pathOf(name), title, count)) {
+            rebuilt++;
+        } else {
+            note("could not rebuild " + name);
+            failed++;
+        }
+    }
+
+    void restoreText(const string& name) {
+        if (skipIfActive(name)) return;
+
+        string title = name.substr(0, name.size() - 4);
+        size_t count = 0;
+        string error;
+        if (Conversation::decodeBinaryFile(pathOf(title + ".cbin"), pathOf(name), count, error)) {
+            restored++;
+        } else {
+            note("could not restore " + name + (error.empty() ? "" : ": " + error));
+            failed++;
+        }
+    }
+
+    bool wanted(Finding::Kind kind) const {
+        switch (kind) {
+            case Finding::CORRUPT: return options.deleteCorrupt;
+            case Finding::ORPHANED_AUTOSAVE: return options.pruneAutosaves;
+            case Finding::LEFTOVER_TEMP: return options.pruneAutosaves;
+            case Finding::DUPLICATE: return options.mergeDuplicates;
+            case Finding::STALE_INDEX: return options.rebuildIndexes;
+        }
+        return false;
+    }
+
+    void repair() {
+        for (const auto& finding : findings) {
+            if (!wanted(finding.kind)) continue;
+
+            string name = finding.name;
+            if (finding.kind == Finding::STALE_INDEX) {
+                pool.submit([this, name] { rebuildIndex(name); });
+            } else if (finding.restorable) {
+                pool.submit([this, name] { restoreText(name); });
+            } else {
+                bool withIndex = finding.kind == Finding::DUPLICATE ||
+                                 finding.kind == Finding::ORPHANED_AUTOSAVE;
+                pool.submit([this, name, withIndex] { removeFile(name, withIndex); });
+            }
+        }
+        pool.wait();
+    }
+
+    static const char* label(Finding::Kind kind) {
+        switch (kind) {
+            case Finding::CORRUPT: return "corrupt";
+            case Finding::ORPHANED_AUTOSAVE: return "orphaned autosave";
+            case Finding::DUPLICATE: return "duplicate";
+            case Finding::STALE_INDEX: return "stale index";
+            case Finding::LEFTOVER_TEMP: return "leftover temp file";
+        }
+        return "";
+    }
+
+    size_t countOf(Finding::Kind kind) const {
+        size_t count = 0;
+        for (const auto& finding : findings) {
+            if (finding.kind == kind) count++;
+        }
+        return count;
+    }
+
+public:
+    explicit ConversationMaintenance(const MaintenanceOptions& opts)
+        : options(opts), pool(opts.threads), bytesRead(0), removed(0), rebuilt(0), restored(0),
+          failed(0) {
+        if (!options.directory.empty() && options.directory.back() != '/') {
+            options.directory += '/';
+        }
+    }
+
+    int run() {
+        struct stat info;
+        if (stat(options.directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+            cerr << "Error: " << options.directory << " is not a directory\n";
+            return 1;
+        }
+
+        auto start = chrono::steady_clock::now();
+        pool.submit([this] { walk(""); });
+        pool.wait();
+        double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        analyze();
+        sort(findings.begin(), findings.end(), [](const Finding& a, const Finding& b) {
+            return a.kind != b.kind ? a.kind < b.kind : a.name < b.name;
+        });
+
+        for (const auto& finding : findings) {
+            cout << left << setw(20) << label(finding.kind) << finding.name << ": "
+                 << finding.detail << "\n";
+        }
+
+        repair();
+        sort(notes.begin(), notes.end());
+        for (const auto& line : notes) {
+            cout << line << "\n";
+        }
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "\n=== Conversation Maintenance ===\n" << fixed << setprecision(1);
+        cout << "  directory:           " << options.directory << "\n";
+        cout << "  files scanned:       " << files.size() << " (" << bytesRead / 1048576.0
+             << " MB, " << pool.size() << " threads)\n";
+        cout << "  scan rate:           " << (scanSeconds > 0 ? files.size() / scanSeconds : 0)
+             << " files/s\n";
+        cout << "  corrupt:             " << countOf(Finding::CORRUPT) << "\n";
+        cout << "  orphaned autosaves:  " << countOf(Finding::ORPHANED_AUTOSAVE) << "\n";
+        cout << "  duplicates:          " << countOf(Finding::DUPLICATE) << "\n";
+        cout << "  stale indexes:       " << countOf(Finding::STALE_INDEX) << "\n";
+        cout << "  leftover temp files: " << countOf(Finding::LEFTOVER_TEMP) << "\n";
+        cout << "  removed:             " << removed << "\n";
+        cout << "  indexes rebuilt:     " << rebuilt << "\n";
+        cout << "  texts restored:      " << restored << "\n";
+        cout << "  failures:            " << failed << "\n";
+        cout << "  total time:          " << seconds << " s\n";
+        return failed > 0 ? 1 : 0;
+    }
+};
+
+#endif
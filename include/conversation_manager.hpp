@@ -0,0 +1,182 @@
+#ifndef CONVERSATION_MANAGER_H
+#define CONVERSATION_MANAGER_H
+
+#include <string>
+#include <list>
+#include <iterator>
+#include <memory>
+#include <iostream>
+#include "conversation.hpp"
+
+using namespace std;
+
+// Keeps recently used conversations live in memory, most recent first.
+// The front entry is the active conversation. Entries past the count or
+// memory cap are flushed and dropped from the back, and reloaded from disk
+// the next time they are opened.
+class ConversationManager {
+public:
+    static constexpr size_t DEFAULT_MAX_RESIDENT = 8;
+    static constexpr size_t DEFAULT_MEMORY_CAP = 32 * 1024 * 1024;
+
+private:
+
+    list<unique_ptr<Conversation>> recent;
+    size_t maxResident;
+    size_t memoryCap;
+    size_t conversationBudget;
+    string saveDir;
+
+    unique_ptr<Conversation> makeConversation() {
+        unique_ptr<Conversation> conv(new Conversation(Conversation::DEFAULT_MEMORY_BUDGET, saveDir));
+        if (conversationBudget > 0) {
+            conv->setMemoryBudget(conversationBudget);
+        }
+        return conv;
+    }
+
+    size_t totalMemory() const {
+        size_t total = 0;
+        for (const auto& conv : recent) {
+            total += conv->memoryUsage();
+        }
+        return total;
+    }
+
+    // An untitled, empty conversation has nothing worth keeping around.
+    void dropIfEmpty(list<unique_ptr<Conversation>>::iterator it) {
+        if ((*it)->isEmpty()) {
+            recent.erase(it);
+        }
+    }
+
+    void evict() {
+        while (recent.size() > 1 &&
+               (recent.size() > maxResident || totalMemory() > memoryCap)) {
+            recent.back()->flush();
+            recent.pop_back();
+        }
+    }
+
+    list<unique_ptr<Conversation>>::iterator findResident(const string& title) {
+        for (auto it = recent.begin(); it != recent.end(); ++it) {
+            if ((*it)->getTitle() == title) return it;
+        }
+        return recent.end();
+    }
+
+    void moveToFront(list<unique_ptr<Conversation>>::iterator it) {
+        if (it == recent.begin()) return;
+
+        auto previous = recent.begin();
+        recent.splice(recent.begin(), recent, it);
+        dropIfEmpty(previous);
+    }
+
+public:
+    explicit ConversationManager(size_t maxConversations = DEFAULT_MAX_RESIDENT,
+                                 size_t memoryCapBytes = DEFAULT_MEMORY_CAP,
+                                 const string& directory = Conversation::DEFAULT_SAVE_DIR)
+        : maxResident(maxConversations), memoryCap(memoryCapBytes), conversationBudget(0),
+          saveDir(directory) {
+        recent.push_back(makeConversation());
+    }
+
+    const string& saveDirectory() const {
+        return saveDir;
+    }
+
+    Conversation& current() {
+        return *recent.front();
+    }
+
+    void setConversationBudget(size_t bytes) {
+        conversationBudget = bytes;
+        for (auto& conv : recent) {
+            conv->setMemoryBudget(bytes);
+        }
+        evict();
+    }
+
+    bool isResident(const string& title) {
+        return findResident(title) != recent.end();
+    }
+
+    // Makes the named conversation active, reusing the live copy when there
+    // is one and otherwise loading it from disk.
+    bool open(const string& title) {
+        auto it = findResident(title);
+        if (it != recent.end()) {
+            moveToFront(it);
+            return true;
+        }
+
+        unique_ptr<Conversation> conv = makeConversation();
+        if (!conv->loadConversationIntoSession(title)) {
+            return false;
+        }
+
+        auto previous = recent.begin();
+        recent.push_front(move(conv));
+        dropIfEmpty(previous);
+        evict();
+        return true;
+    }
+
+    // Saves the active conversation. Another resident conversation under
+    // the same title would keep appending to the file this save replaces,
+    // so it is flushed and dropped first.
+    void saveCurrent(const string& title) {
+        for (auto it = next(recent.begin()); it != recent.end();) {
+            if ((*it)->getTitle() == title) {
+                (*it)->flush();
+                it = recent.erase(it);
+                cout << "Closed the older copy of " << title << " in the recent list.\n";
+            } else {
+                ++it;
+            }
+        }
+        current().saveConversation(title);
+    }
+
+    // Switches to the nth entry of the recent list (1 is the active one).
+    bool switchTo(size_t number) {
+        if (number < 1 || number > recent.size()) {
+            return false;
+        }
+
+        auto it = recent.begin();
+        advance(it, number - 1);
+        moveToFront(it);
+        return true;
+    }
+
+    void startNew() {
+        auto previous = recent.begin();
+        recent.push_front(makeConversation());
+        dropIfEmpty(previous);
+        evict();
+    }
+
+    void listRecent() {
+        cout << "\n=== Recent Conversations ===\n";
+        int count = 0;
+        for (const auto& conv : recent) {
+            string title = conv->getTitle();
+            count++;
+            cout << count << ". " << (title.empty() ? "(new conversation)" : title)
+                 << " - " << conv->messageCount() << " messages"
+                 << (count == 1 ? " (active)" : "") << "\n";
+        }
+    }
+
+    bool flushAll() {
+        bool ok = true;
+        for (auto& conv : recent) {
+            ok = conv->flush() && ok;
+        }
+        return ok;
+    }
+};
+
+#endif
@@ -0,0 +1,577 @@
+#ifndef IO_BACKEND_H
+#define IO_BACKEND_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define CHATBOT_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#endif
+#endif
+
+using namespace std;
+
+struct IoRequest {
+    enum Op { WRITE, READ, FSYNC };
+
+    Op op;
+    int fd;
+    void* buf;
+    size_t len;
+    int64_t offset;
+    ssize_t result;
+
+    IoRequest() : op(WRITE), fd(-1), buf(nullptr), len(0), offset(-1), result(0) {}
+};
+
+// A chain of requests runs in order and completes as a unit; a failed
+// request cancels the rest of its chain. offset -1 means "current file
+// position", which for O_APPEND files is an append.
+class IoBackend {
+protected:
+    struct Batch {
+        vector<IoRequest>* chain;
+        size_t pending;
+        bool done;
+    };
+
+    mutex queueMutex;
+    condition_variable queueCv;
+    condition_variable doneCv;
+    deque<Batch*> queue;
+    bool stopping;
+
+    IoBackend() : stopping(false) {}
+
+    void complete(const vector<Batch*>& batches) {
+        lock_guard<mutex> lock(queueMutex);
+        for (auto* batch : batches) {
+            batch->done = true;
+        }
+        doneCv.notify_all();
+    }
+
+    // With wait, blocks until at least one batch is queued and may exceed
+    // maxRequests for that first batch; without it, takes only what fits.
+    // Returns false once shutting down with nothing queued.
+    bool takeBatches(vector<Batch*>& out, size_t maxRequests, bool wait = true) {
+        unique_lock<mutex> lock(queueMutex);
+        if (wait) {
+            queueCv.wait(lock, [this] { return stopping || !queue.empty(); });
+        }
+        if (queue.empty()) return !stopping;
+
+        size_t requests = 0;
+        while (!queue.empty()) {
+            size_t n = queue.front()->chain->size();
+            if ((!out.empty() || !wait) && requests + n > maxRequests) break;
+            requests += n;
+            out.push_back(queue.front());
+            queue.pop_front();
+        }
+        return true;
+    }
+
+    void shutdown() {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+        queueCv.notify_all();
+    }
+
+    // Called with queueMutex held whenever a batch is queued.
+    virtual void wake() {
+        queueCv.notify_one();
+    }
+
+    static void runBlocking(vector<IoRequest>& chain) {
+        bool cancelled = false;
+        for (auto& req : chain) {
+            if (cancelled) {
+                req.result = -ECANCELED;
+                continue;
+            }
+
+            ssize_t n;
+            do {
+                switch (req.op) {
+                    case IoRequest::WRITE:
+                        n = req.offset < 0 ? ::write(req.fd, req.buf, req.len)
+                                           : pwrite(req.fd, req.buf, req.len, req.offset);
+                        break;
+                    case IoRequest::READ:
+                        n = req.offset < 0 ? ::read(req.fd, req.buf, req.len)
+                                           : pread(req.fd, req.buf, req.len, req.offset);
+                        break;
+                    default:
+                        n = fdatasync(req.fd);
+                        break;
+                }
+            } while (n < 0 && errno == EINTR);
+
+            req.result = n < 0 ? -errno : n;
+            if (n < 0 || (req.op != IoRequest::FSYNC && (size_t)n < req.len)) {
+                cancelled = true;
+            }
+        }
+    }
+
+public:
+    virtual ~IoBackend() {}
+
+    virtual const char* name() const = 0;
+
+    // Queues the chain alongside other sessions' chains and waits for it.
+    void submit(vector<IoRequest>& chain) {
+        Batch batch;
+        batch.chain = &chain;
+        batch.pending = chain.size();
+        batch.done = false;
+
+        unique_lock<mutex> lock(queueMutex);
+        queue.push_back(&batch);
+        wake();
+        doneCv.wait(lock, [&batch] { return batch.done; });
+    }
+
+    bool writeAll(int fd, const string& data, bool sync) {
+        size_t done = 0;
+        while (done < data.size() || sync) {
+            vector<IoRequest> chain;
+            if (done < data.size()) {
+                IoRequest req;
+                req.op = IoRequest::WRITE;
+                req.fd = fd;
+                req.buf = (void*)(data.data() + done);
+                req.len = data.size() - done;
+                chain.push_back(req);
+            }
+            if (sync) {
+                IoRequest req;
+                req.op = IoRequest::FSYNC;
+                req.fd = fd;
+                chain.push_back(req);
+            }
+
+            submit(chain);
+
+            if (chain[0].op == IoRequest::WRITE) {
+                if (chain[0].result < 0) {
+                    errno = -chain[0].result;
+                    return false;
+                }
+                done += chain[0].result;
+                if (done < data.size()) continue;
+            }
+            if (sync) {
+                if (chain.back().result < 0) {
+                    errno = -chain.back().result;
+                    return false;
+                }
+                sync = false;
+            }
+        }
+        return true;
+    }
+
+    bool sync(int fd) {
+        return writeAll(fd, "", true);
+    }
+
+    // False on any read error; a file that shrank meanwhile is returned
+    // as far as it goes.
+    bool readFile(const string& path, string& out) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+
+        out.assign(info.st_size, '\0');
+        size_t done = 0;
+        while (done < out.size()) {
+            vector<IoRequest> chain(1);
+            chain[0].op = IoRequest::READ;
+            chain[0].fd = fd;
+            chain[0].buf = &out[done];
+            chain[0].len = out.size() - done;
+            chain[0].offset = done;
+            submit(chain);
+
+            if (chain[0].result < 0) {
+                close(fd);
+                out.clear();
+                return false;
+            }
+            if (chain[0].result == 0) break;
+            done += chain[0].result;
+        }
+        out.resize(done);
+        close(fd);
+        return true;
+    }
+
+    static IoBackend& shared();
+};
+
+class ThreadPoolIoBackend : public IoBackend {
+private:
+    vector<thread> workers;
+
+    void run() {
+        vector<Batch*> batches;
+        while (takeBatches(batches, 1)) {
+            for (auto* batch : batches) {
+                runBlocking(*batch->chain);
+            }
+            complete(batches);
+            batches.clear();
+        }
+    }
+
+public:
+    explicit ThreadPoolIoBackend(unsigned threads = 0) {
+        if (threads == 0) {
+            threads = max(8u, 2 * thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back(&ThreadPoolIoBackend::run, this);
+        }
+    }
+
+    ~ThreadPoolIoBackend() {
+        shutdown();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    const char* name() const {
+        return "threads";
+    }
+};
+
+#ifdef CHATBOT_HAVE_URING
+// Talks to io_uring through the raw syscalls, so no liburing is needed.
+// A single submitter thread keeps the ring full: every pass it adds all
+// newly queued chains (linked per chain), enters the kernel once and
+// completes each chain as soon as its last CQE arrives, so a slow fsync
+// never holds back other sessions' requests. A read on an eventfd stays
+// in the ring so that queueing a chain wakes the submitter.
+class UringIoBackend : public IoBackend {
+private:
+    static constexpr unsigned QUEUE_DEPTH = 256;
+    static constexpr uint64_t WAKE_TAG = ~0ULL;
+
+    struct Slot {
+        Batch* batch;
+        IoRequest* req;
+    };
+
+    int ringFd;
+    unsigned sqEntries;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    io_uring_sqe* sqes;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    io_uring_cqe* cqes;
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+    int wakeFd;
+    uint64_t wakeValue;
+    vector<Slot> slots;
+    vector<unsigned> freeSlots;
+    thread submitter;
+
+    static int enter(int fd, unsigned toSubmit, unsigned minComplete) {
+        int ret;
+        do {
+            ret = syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+                          IORING_ENTER_GETEVENTS, nullptr, 0);
+        } while (ret < 0 && errno == EINTR);
+        return ret;
+    }
+
+    bool supportsOps() {
+        size_t size = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+        unique_ptr<char[]> buf(new char[size]());
+        io_uring_probe* probe = (io_uring_probe*)buf.get();
+
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+            return false;
+        }
+
+        const int needed[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC};
+        for (int op : needed) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void fill(io_uring_sqe* sqe, IoRequest& req, uint64_t tag, bool linked) {
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->fd = req.fd;
+        sqe->user_data = tag;
+        if (linked) sqe->flags = IOSQE_IO_LINK;
+
+        if (req.op == IoRequest::FSYNC) {
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            return;
+        }
+
+        sqe->opcode = req.op == IoRequest::WRITE ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->addr = (uint64_t)(uintptr_t)req.buf;
+        sqe->len = req.len;
+        sqe->off = (uint64_t)req.offset;
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t n = ::write(wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+
+    // A request's result is final; its chain completes with its last one.
+    void finish(uint64_t tag, ssize_t result, vector<Batch*>& done) {
+        Slot& slot = slots[tag];
+        slot.req->result = result;
+        if (--slot.batch->pending == 0) done.push_back(slot.batch);
+        freeSlots.push_back((unsigned)tag);
+    }
+
+    void run() {
+        IoRequest wakeRead;
+        wakeRead.op = IoRequest::READ;
+        wakeRead.fd = wakeFd;
+        wakeRead.buf = &wakeValue;
+        wakeRead.len = sizeof(wakeValue);
+        wakeRead.offset = -1;
+
+        vector<Batch*> batches;
+        vector<Batch*> done;
+        bool wakeArmed = false;
+        bool open = true;
+        unsigned tail = *sqTail;
+        unsigned toSubmit = 0;
+
+        // Callers free their chains once complete() runs, so every SQE
+        // published must either come back as a CQE or be withdrawn before
+        // the kernel sees it.
+        while (true) {
+            if (open) {
+                open = takeBatches(batches, freeSlots.size(), false);
+            }
+            if (!open && batches.empty() && freeSlots.size() == slots.size()) {
+                break;
+            }
+            if (open && !wakeArmed) {
+                fill(&sqes[tail & *sqMask], wakeRead, WAKE_TAG, false);
+                sqArray[tail & *sqMask] = tail & *sqMask;
+                tail++;
+                toSubmit++;
+                wakeArmed = true;
+            }
+            for (auto* batch : batches) {
+                vector<IoRequest>& chain = *batch->chain;
+                for (size_t i = 0; i < chain.size(); i++) {
+                    unsigned tag = freeSlots.back();
+                    freeSlots.pop_back();
+                    slots[tag] = {batch, &chain[i]};
+
+                    unsigned index = tail & *sqMask;
+                    fill(&sqes[index], chain[i], tag, i + 1 < chain.size());
+                    sqArray[index] = index;
+                    tail++;
+                    toSubmit++;
+                }
+            }
+            batches.clear();
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+            int ret = enter(ringFd, toSubmit, 1);
+            if (ret >= 0) {
+                toSubmit -= ret < (int)toSubmit ? ret : toSubmit;
+            } else if (toSubmit > 0 && errno != EAGAIN && errno != EBUSY) {
+                // Hard failure: take back what the kernel has not consumed.
+                int err = errno;
+                unsigned consumed = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+                for (unsigned pos = consumed; pos != tail; pos++) {
+                    uint64_t tag = sqes[pos & *sqMask].user_data;
+                    if (tag == WAKE_TAG) {
+                        wakeArmed = false;
+                    } else {
+                        finish(tag, -err, done);
+                    }
+                }
+                tail = consumed;
+                __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+                toSubmit = 0;
+            }
+
+            bool progress = !done.empty();
+            unsigned head = *cqHead;
+            while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                io_uring_cqe* cqe = &cqes[head & *cqMask];
+                if (cqe->user_data == WAKE_TAG) {
+                    wakeArmed = false;
+                } else {
+                    finish(cqe->user_data, cqe->res, done);
+                }
+                head++;
+                progress = true;
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+            if (!done.empty()) {
+                complete(done);
+                done.clear();
+            }
+            if (ret < 0 && !progress) {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }
+    }
+
+public:
+    UringIoBackend() : ringFd(-1), sqes((io_uring_sqe*)MAP_FAILED), sqRing(MAP_FAILED),
+                       cqRing(MAP_FAILED), wakeFd(-1), wakeValue(0) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        ringFd = syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+        if (ringFd < 0) return;
+        if (!supportsOps()) {
+            close(ringFd);
+            ringFd = -1;
+            return;
+        }
+
+        sqEntries = params.sq_entries;
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) {
+            sqRingSize = cqRingSize = max(sqRingSize, cqRingSize);
+        }
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+        cqRing = singleMap ? sqRing
+                           : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+            release();
+            return;
+        }
+
+        char* sq = (char*)sqRing;
+        char* cq = (char*)cqRing;
+        sqHead = (unsigned*)(sq + params.sq_off.head);
+        sqTail = (unsigned*)(sq + params.sq_off.tail);
+        sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+        sqArray = (unsigned*)(sq + params.sq_off.array);
+        cqHead = (unsigned*)(cq + params.cq_off.head);
+        cqTail = (unsigned*)(cq + params.cq_off.tail);
+        cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+
+        wakeFd = eventfd(0, EFD_CLOEXEC);
+        if (wakeFd < 0) {
+            release();
+            return;
+        }
+
+        // One SQ entry stays free for the eventfd read; the CQ ring holds
+        // at least as many entries as the SQ, so it never overflows.
+        slots.resize(sqEntries - 1);
+        for (unsigned i = 0; i < slots.size(); i++) {
+            freeSlots.push_back(i);
+        }
+
+        submitter = thread(&UringIoBackend::run, this);
+    }
+
+    ~UringIoBackend() {
+        shutdown();
+        if (wakeFd >= 0) wake();
+        if (submitter.joinable()) submitter.join();
+        release();
+    }
+
+    void release() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        sqes = (io_uring_sqe*)MAP_FAILED;
+        sqRing = cqRing = MAP_FAILED;
+        if (ringFd >= 0) close(ringFd);
+        ringFd = -1;
+        if (wakeFd >= 0) close(wakeFd);
+        wakeFd = -1;
+    }
+
+    bool available() const {
+        return ringFd >= 0;
+    }
+
+    const char* name() const {
+        return "io_uring";
+    }
+};
+#endif
+
+// CHATBOT_IO_BACKEND=threads forces the thread pool; otherwise io_uring is
+// used when the kernel allows it.
+inline IoBackend& IoBackend::shared() {
+    static unique_ptr<IoBackend> backend = [] {
+        const char* choice = getenv("CHATBOT_IO_BACKEND");
+        bool wantUring = !choice || string(choice) != "threads";
+#ifdef CHATBOT_HAVE_URING
+        if (wantUring) {
+            unique_ptr<UringIoBackend> uring(new UringIoBackend());
+            if (uring->available()) return unique_ptr<IoBackend>(uring.release());
+        }
+#else
+        (void)wantUring;
+#endif
+        return unique_ptr<IoBackend>(new ThreadPoolIoBackend());
+    }();
+    return *backend;
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef KNOWLEDGE_BASE_H
+#define KNOWLEDGE_BASE_H
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+struct QAEntry {
+    string_view question;
+    string_view answer;
+};
+
+enum CommandKind : uint8_t {
+    CMD_EXIT,
+    CMD_CLOSE,
+    CMD_NEW_CONVERSATION,
+    CMD_LIST_CONVO,
+    CMD_LIST_QUESTION,
+    CMD_SAVE,
+    CMD_CLEAR,
+    CMD_HELP
+};
+
+struct CommandEntry {
+    string_view text;
+    CommandKind kind;
+};
+
+// Built-in tables live in read-only data; nothing here allocates at startup.
+// Questions are kept in alphabetical order so their position is the number
+// shown by "list question".
+namespace kb {
+
+constexpr QAEntry QUESTIONS[] = {
+    {"fifo pipes",
+     "FIFO (First In First Out) pipes, also called named pipes, are similar to regular "
+     "pipes but have a name in the filesystem. Unlike anonymous pipes, FIFOs can be used "
+     "by unrelated processes and persist beyond the process that created them. Created "
+     "using mkfifo() system call."},
+    {"file operations",
+     "File operations in Unix/Linux include: open() to open files, read() to read data, "
+     "write() to write data, close() to close files, lseek() to move file pointer, "
+     "stat() to get file information, and unlink() to delete files. File descriptors "
+     "(integers) are used to reference open files. Standard descriptors: 0=stdin, 1=stdout, 2=stderr."},
+    {"process management",
+     "Process management involves creating (fork()), executing (exec()), terminating (exit()), "
+     "and monitoring processes. Key system calls: fork() creates child process, wait()/waitpid() "
+     "waits for child termination, getpid() returns process ID, getppid() returns parent ID, "
+     "kill() sends signals to processes. Process states: running, waiting, stopped, zombie."},
+    {"shared resources",
+     "Shared resources are memory regions or system resources that multiple processes or "
+     "threads can access concurrently. Common examples include shared memory segments, "
+     "files, and hardware devices. Proper synchronization mechanisms like semaphores, "
+     "mutexes, or locks are needed to prevent race conditions."},
+    {"what are pipes",
+     "Pipes are a method of inter-process communication (IPC) that allow data to flow "
+     "from one process to another. The pipe() system call creates a unidirectional "
+     "communication channel where one process writes to the pipe and another reads from it."},
+    {"what are semaphores",
+     "Semaphores are synchronization primitives used to control access to shared resources. "
+     "They maintain a counter: P() (wait/down) decrements it, V() (signal/up) increments it. "
+     "Binary semaphores (0 or 1) act like locks. Counting semaphores allow multiple access. "
+     "POSIX provides sem_init(), sem_wait(), sem_post(), sem_destroy(). Used to prevent race conditions."},
+    {"what is a process",
+     "A process is an instance of a running program. It contains the program code "
+     "and its current activity. Each process has its own memory space and system resources."},
+    {"what is exec",
+     "The exec family of functions replaces the current process image with a new program. "
+     "Common variants include: execl(), execv(), execle(), execve(), execlp(), execvp(). "
+     "They differ in how arguments are passed (list vs array) and whether they use PATH "
+     "or environment variables. After exec, the new program runs in the same process ID."},
+    {"what is fork",
+     "fork() is a system call that creates a new process by duplicating the calling "
+     "process. The new process is called the child process, and it runs concurrently "
+     "with the parent process."},
+    {"what is multithreading",
+     "Multithreading is the ability of a CPU to execute multiple threads concurrently. "
+     "Threads are lightweight processes that share the same memory space, making "
+     "communication between them faster than inter-process communication."},
+    {"what is tmux",
+     "Tmux is a terminal multiplexer that allows you to create, access, and control "
+     "multiple terminals from a single screen. It's useful for managing multiple "
+     "terminal sessions."},
+};
+
+constexpr CommandEntry COMMANDS[] = {
+    {"exit", CMD_EXIT},
+    {"quit", CMD_EXIT},
+    {"bye", CMD_EXIT},
+    {"goodbye", CMD_EXIT},
+    {"close panel", CMD_CLOSE},
+    {"close", CMD_CLOSE},
+    {"hide answer", CMD_CLOSE},
+    {"new conversation", CMD_NEW_CONVERSATION},
+    {"start new", CMD_NEW_CONVERSATION},
+    {"restart", CMD_NEW_CONVERSATION},
+    {"new", CMD_NEW_CONVERSATION},
+    {"list convo", CMD_LIST_CONVO},
+    {"list question", CMD_LIST_QUESTION},
+    {"save", CMD_SAVE},
+    {"clear", CMD_CLEAR},
+    {"help", CMD_HELP},
+};
+
+constexpr size_t QUESTION_COUNT = sizeof(QUESTIONS) / sizeof(QUESTIONS[0]);
+constexpr size_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+constexpr uint32_t hash(string_view text, uint32_t seed) {
+    uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char c : text) {
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+template <size_t Slots>
+struct PerfectHash {
+    uint32_t seed;
+    uint8_t slots[Slots];  // entry index + 1, 0 for an empty slot
+};
+
+// Tries seeds until every key lands in its own slot. Runs at compile time;
+// duplicate keys make the search fail to terminate, which the compiler
+// reports as a constexpr evaluation error.
+template <size_t Slots, typename Entry, size_t N>
+constexpr PerfectHash<Slots> buildPerfectHash(const Entry (&entries)[N],
+                                              string_view Entry::*key) {
+    static_assert((Slots & (Slots - 1)) == 0, "slot count must be a power of two");
+    static_assert(N < Slots && Slots <= 256, "too many entries for the table");
+
+    for (uint32_t seed = 0;; seed++) {
+        PerfectHash<Slots> table{seed, {}};
+        bool collision = false;
+
+        for (size_t i = 0; i < N && !collision; i++) {
+            size_t slot = hash(entries[i].*key, seed) & (Slots - 1);
+            if (table.slots[slot] != 0) {
+                collision = true;
+            } else {
+                table.slots[slot] = (uint8_t)(i + 1);
+            }
+        }
+        if (!collision) return table;
+    }
+}
+
+template <size_t Slots, typename Entry, size_t N>
+constexpr int lookup(const PerfectHash<Slots>& table, const Entry (&entries)[N],
+                     string_view Entry::*key, string_view text) {
+    uint8_t slot = table.slots[hash(text, table.seed) & (Slots - 1)];
+    return (slot != 0 && entries[slot - 1].*key == text) ? slot - 1 : -1;
+}
+
+constexpr auto QUESTION_HASH = buildPerfectHash<32>(QUESTIONS, &QAEntry::question);
+constexpr auto COMMAND_HASH = buildPerfectHash<64>(COMMANDS, &CommandEntry::text);
+
+constexpr bool questionsSorted() {
+    for (size_t i = 1; i < QUESTION_COUNT; i++) {
+        if (!(QUESTIONS[i - 1].question < QUESTIONS[i].question)) return false;
+    }
+    return true;
+}
+
+// findAnswer returns the first question contained in the input. An exact
+// hit can skip that scan only if no other question is a substring of it.
+constexpr bool questionsPrefixFree() {
+    for (size_t i = 0; i < QUESTION_COUNT; i++) {
+        for (size_t j = 0; j < QUESTION_COUNT; j++) {
+            if (i != j && QUESTIONS[i].question.find(QUESTIONS[j].question) != string_view::npos) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Likewise, an input equal to a command may contain other commands only
+// of the same kind, so an exact hit decides every is*Command() at once.
+constexpr bool commandsUnambiguous() {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        for (size_t j = 0; j < COMMAND_COUNT; j++) {
+            if (COMMANDS[i].kind != COMMANDS[j].kind &&
+                COMMANDS[i].text.find(COMMANDS[j].text) != string_view::npos) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(questionsSorted(), "built-in questions must stay in alphabetical order");
+static_assert(questionsPrefixFree(), "a built-in question contains another one");
+static_assert(commandsUnambiguous(), "a command contains a command of another kind");
+
+}
+
+#endif
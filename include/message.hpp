@@ -0,0 +1,30 @@
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include <string>
+
+using namespace std;
+
+struct Message {
+    string type;
+    string content;
+    string timestamp;
+};
+
+inline string formatConversationHeader(const string& title, const string& date) {
+    return "Title: " + title + "\n" +
+           "Date: " + date + "\n" +
+           "=====================================\n\n";
+}
+
+inline void appendMessageLine(string& out, const Message& msg) {
+    out += '[';
+    out += msg.timestamp;
+    out += "] ";
+    out += msg.type;
+    out += ": ";
+    out += msg.content;
+    out += "\n\n";
+}
+
+#endif
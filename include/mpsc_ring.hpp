@@ -0,0 +1,88 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Bounded lock-free multi-producer/single-consumer ring (Vyukov's
+// sequence-per-cell queue). Capacity is rounded up to a power of two.
+template <typename T>
+class MpscRing {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> head;
+    alignas(64) atomic<size_t> tail;
+
+public:
+    explicit MpscRing(size_t requested) : mask(0), head(0), tail(0) {
+        size_t capacity = 2;
+        while (capacity < requested) capacity <<= 1;
+
+        cells.reset(new Cell[capacity]);
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    // Moves from value only when the push succeeds.
+    bool tryPush(T& value) {
+        size_t pos = head.load(memory_order_relaxed);
+        Cell* cell;
+
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load(memory_order_relaxed);
+            }
+        }
+
+        cell->data = move(value);
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = tail.load(memory_order_relaxed);
+        Cell* cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(memory_order_acquire);
+
+        if ((intptr_t)seq - (intptr_t)(pos + 1) != 0) {
+            return false;
+        }
+
+        tail.store(pos + 1, memory_order_relaxed);
+        out = move(cell->data);
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    size_t sizeApprox() const {
+        size_t h = head.load(memory_order_relaxed);
+        size_t t = tail.load(memory_order_relaxed);
+        return h > t ? h - t : 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+#endif
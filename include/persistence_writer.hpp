@@ -0,0 +1,285 @@
+#ifndef PERSISTENCE_WRITER_H
+#define PERSISTENCE_WRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "message.hpp"
+#include "mpsc_ring.hpp"
+#include "io_backend.hpp"
+#include "spill_segment.hpp"
+
+using namespace std;
+
+struct PersistOp {
+    enum Kind { APPEND, OPEN, REWRITE, CLOSE, SPILL };
+
+    Kind kind;
+    Message msg;
+    string path;
+    string title;
+    string removePath;
+    shared_ptr<SpillSegment> spill;
+    vector<SpilledMessage> spilled;
+    vector<Message> snapshot;
+    string spillData;
+    uint64_t spillOffset;
+
+    PersistOp() : kind(APPEND), spillOffset(0) {}
+};
+
+// Owns the conversation file. Producers push ops into a lock-free ring and
+// return immediately; the writer thread drains whatever has queued and
+// commits it with one write() (group commit), followed by fdatasync() when a
+// flush() barrier is waiting or syncOnCommit is set.
+class PersistenceWriter {
+private:
+    static constexpr size_t RING_CAPACITY = 1024;
+    static constexpr int COMMIT_INTERVAL_MS = 100;
+    static constexpr size_t REWRITE_CHUNK_BYTES = 1 << 20;
+
+    MpscRing<PersistOp> ring;
+    atomic<bool> running;
+    atomic<bool> failed;
+    atomic<int> flushWaiters;
+    atomic<uint64_t> enqueued;
+    atomic<uint64_t> committed;
+    atomic<uint64_t> synced;
+    bool syncOnCommit;
+    IoBackend& io;
+
+    mutex wakeMutex;
+    condition_variable wakeCv;
+    condition_variable doneCv;
+    string lastError;
+
+    int fd;
+    bool fileDirty;
+    string path;
+    string pending;
+    thread worker;
+
+    static string currentTimestamp() {
+        time_t now = time(0);
+        char buf[80];
+        struct tm local;
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime_r(&now, &local));
+        return string(buf);
+    }
+
+    void setError(const string& what) {
+        lock_guard<mutex> lock(wakeMutex);
+        lastError = what + ": " + strerror(errno);
+        failed = true;
+    }
+
+    void commitPending() {
+        if (pending.empty()) return;
+        if (fd < 0) {
+            pending.clear();
+            return;
+        }
+        if (!io.writeAll(fd, pending, false)) {
+            setError("Could not write " + path);
+        }
+        pending.clear();
+        fileDirty = true;
+    }
+
+    void syncFile() {
+        if (fd >= 0 && fileDirty && !io.sync(fd)) {
+            setError("Could not sync " + path);
+        }
+        fileDirty = false;
+    }
+
+    void closeFile() {
+        commitPending();
+        syncFile();
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        path.clear();
+    }
+
+    void openFile(const string& target, const string& title) {
+        closeFile();
+
+        fd = open(target.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (fd < 0) {
+            setError("Could not open " + target);
+            return;
+        }
+        path = target;
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size == 0) {
+            pending += formatConversationHeader(title, currentTimestamp());
+        }
+    }
+
+    void rewriteFile(PersistOp& op) {
+        closeFile();
+
+        // Unique temp name: several sessions may rewrite the same title at once.
+        string tmpPath = op.path + ".XXXXXX";
+        int out = mkstemp(&tmpPath[0]);
+        if (out < 0) {
+            setError("Could not save " + op.path);
+            return;
+        }
+        fchmod(out, 0644);
+
+        string data = formatConversationHeader(op.title, currentTimestamp());
+        bool ok = true;
+        Message paged;
+
+        for (size_t i = 0; ok && i < op.spilled.size(); i++) {
+            ok = op.spill->load(op.spilled[i], paged);
+            appendMessageLine(data, paged);
+            if (data.size() >= REWRITE_CHUNK_BYTES) {
+                ok = ok && io.writeAll(out, data, false);
+                data.clear();
+            }
+        }
+        for (size_t i = 0; ok && i < op.snapshot.size(); i++) {
+            appendMessageLine(data, op.snapshot[i]);
+            if (data.size() >= REWRITE_CHUNK_BYTES) {
+                ok = io.writeAll(out, data, false);
+                data.clear();
+            }
+        }
+
+        ok = ok && io.writeAll(out, data, true);
+        close(out);
+        if (!ok || rename(tmpPath.c_str(), op.path.c_str()) != 0) {
+            setError("Could not save " + op.path);
+            unlink(tmpPath.c_str());
+            return;
+        }
+
+        if (!op.removePath.empty() && op.removePath != op.path) {
+            unlink(op.removePath.c_str());
+        }
+        openFile(op.path, op.title);
+    }
+
+    uint64_t drain() {
+        uint64_t count = 0;
+        PersistOp op;
+
+        while (ring.tryPop(op)) {
+            count++;
+            switch (op.kind) {
+                case PersistOp::APPEND:
+                    appendMessageLine(pending, op.msg);
+                    break;
+                case PersistOp::OPEN:
+                    openFile(op.path, op.title);
+                    break;
+                case PersistOp::REWRITE:
+                    rewriteFile(op);
+                    break;
+                case PersistOp::CLOSE:
+                    closeFile();
+                    break;
+                case PersistOp::SPILL:
+                    if (!op.spill->writeAt(op.spillData, op.spillOffset)) {
+                        setError("Could not write spill segment");
+                    }
+                    break;
+            }
+        }
+
+        commitPending();
+        return count;
+    }
+
+    void run() {
+        while (true) {
+            {
+                unique_lock<mutex> lock(wakeMutex);
+                wakeCv.wait_for(lock, chrono::milliseconds(COMMIT_INTERVAL_MS), [this] {
+                    return !running.load() || ring.sizeApprox() >= RING_CAPACITY / 2 ||
+                           (flushWaiters.load() > 0 && synced.load() < enqueued.load());
+                });
+            }
+
+            bool stopping = !running.load();
+            committed += drain();
+            if (syncOnCommit || flushWaiters.load() > 0 || stopping) {
+                syncFile();
+                synced = committed.load();
+            }
+
+            {
+                lock_guard<mutex> lock(wakeMutex);
+                doneCv.notify_all();
+            }
+
+            if (stopping && ring.sizeApprox() == 0) break;
+        }
+        closeFile();
+    }
+
+public:
+    explicit PersistenceWriter(bool syncEveryCommit = false)
+        : ring(RING_CAPACITY), running(true), failed(false), flushWaiters(0),
+          enqueued(0), committed(0), synced(0), syncOnCommit(syncEveryCommit),
+          io(IoBackend::shared()), fd(-1),
+          fileDirty(false) {
+        worker = thread(&PersistenceWriter::run, this);
+    }
+
+    ~PersistenceWriter() {
+        running = false;
+        wakeCv.notify_one();
+        worker.join();
+    }
+
+    // Never blocks on I/O; spins with yield only while the ring is full.
+    void submit(PersistOp& op) {
+        while (!ring.tryPush(op)) {
+            wakeCv.notify_one();
+            this_thread::yield();
+        }
+        enqueued++;
+    }
+
+    // Waits until everything submitted so far is written and synced.
+    // Returns false if any commit failed since the last flush.
+    bool flush() {
+        uint64_t target = enqueued.load();
+        flushWaiters++;
+
+        unique_lock<mutex> lock(wakeMutex);
+        wakeCv.notify_one();
+        doneCv.wait(lock, [this, target] { return synced.load() >= target; });
+        flushWaiters--;
+
+        return !failed.exchange(false);
+    }
+
+    string takeError() {
+        lock_guard<mutex> lock(wakeMutex);
+        string error = lastError;
+        lastError.clear();
+        return error;
+    }
+};
+
+#endif
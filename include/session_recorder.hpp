@@ -0,0 +1,90 @@
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "conversation_codec.hpp"
+
+using namespace std;
+
+// Session recording (.crec):
+//
+//   header : "CHRS" | u8 version
+//   record : varint delayMs since previous line | varint len | line
+
+struct RecordedLine {
+    uint64_t delayMs;
+    string line;
+};
+
+class SessionRecorder {
+private:
+    static constexpr char MAGIC[4] = {'C', 'H', 'R', 'S'};
+    static constexpr uint8_t VERSION = 1;
+
+    ofstream out;
+    chrono::steady_clock::time_point last;
+
+public:
+    explicit SessionRecorder(const string& path)
+        : out(path, ios::binary | ios::trunc), last(chrono::steady_clock::now()) {
+        if (!out.is_open()) {
+            cerr << "Error: Could not open recording file " << path << "\n";
+            return;
+        }
+        out.write(MAGIC, sizeof(MAGIC));
+        out.put((char)VERSION);
+        out.flush();
+    }
+
+    bool isOpen() const {
+        return out.is_open();
+    }
+
+    // Flushed per line so a crashed session still leaves a usable recording.
+    void record(const string& line) {
+        if (!out.is_open()) return;
+
+        auto now = chrono::steady_clock::now();
+        uint64_t delay = chrono::duration_cast<chrono::milliseconds>(now - last).count();
+        last = now;
+
+        string rec;
+        cbin::putVarint(rec, delay);
+        cbin::putVarint(rec, line.size());
+        rec += line;
+        out.write(rec.data(), rec.size());
+        out.flush();
+    }
+
+    static bool load(const string& path, vector<RecordedLine>& lines) {
+        ifstream in(path, ios::binary);
+        if (!in.is_open()) {
+            cerr << "Error: Could not open recording " << path << "\n";
+            return false;
+        }
+
+        char magic[4];
+        if (!in.read(magic, 4) || memcmp(magic, MAGIC, 4) != 0 || in.get() != VERSION) {
+            cerr << "Error: " << path << " is not a session recording\n";
+            return false;
+        }
+
+        RecordedLine rec;
+        uint64_t len;
+        while (cbin::readVarint(in, rec.delayMs)) {
+            if (!cbin::readVarint(in, len) || len > cbin::MAX_BLOCK_SIZE) break;
+            rec.line.assign(len, '\0');
+            if (len > 0 && !in.read(&rec.line[0], len)) break;
+            lines.push_back(rec);
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef SESSION_REPLAYER_H
+#define SESSION_REPLAYER_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include "chat_session.hpp"
+#include "session_recorder.hpp"
+
+using namespace std;
+
+class ReplayLineSource : public LineSource {
+private:
+    const vector<RecordedLine>& lines;
+    size_t next;
+    double speed;
+
+public:
+    ReplayLineSource(const vector<RecordedLine>& recorded, double replaySpeed)
+        : lines(recorded), next(0), speed(replaySpeed) {}
+
+    bool readLine(string& line) {
+        if (next >= lines.size()) return false;
+        line = lines[next++].line;
+        return true;
+    }
+
+    // Sleeps for the recorded think time before the next command; a speed
+    // of 0 replays as fast as possible. Prompt answers read inside a command
+    // are not paced, so they never count towards its latency.
+    bool waitForNext() {
+        if (next >= lines.size()) return false;
+        if (speed > 0) {
+            this_thread::sleep_for(chrono::microseconds(
+                (long long)(lines[next].delayMs * 1000 / speed)));
+        }
+        return true;
+    }
+};
+
+// Feeds recorded sessions through ChatSession concurrently, one thread and
+// one engine per session, with the answer panel disabled and all output
+// discarded, then reports throughput and per-command latency percentiles.
+class SessionReplayer {
+private:
+    struct Sample {
+        string command;
+        double micros;
+    };
+
+    class NullBuffer : public streambuf {
+    protected:
+        int overflow(int c) {
+            return c;
+        }
+    };
+
+    vector<vector<RecordedLine>> recordings;
+    double speed;
+    int copies;
+
+    static void runSession(const vector<RecordedLine>* lines, double speed,
+                           string saveDir, vector<Sample>* samples) {
+        Chatbot chatbot;
+        TmuxManager tmux(true);
+        ConversationManager conversations(ConversationManager::DEFAULT_MAX_RESIDENT,
+                                          ConversationManager::DEFAULT_MEMORY_CAP, saveDir);
+        ReplayLineSource source(*lines, speed);
+        ChatSession session(chatbot, tmux, conversations, source, true);
+
+        string line;
+        while (source.waitForNext() && source.readLine(line)) {
+            string command;
+            auto start = chrono::steady_clock::now();
+            bool keepGoing = session.handle(line, &command);
+            auto end = chrono::steady_clock::now();
+
+            if (!line.empty()) {
+                samples->push_back({command, chrono::duration<double, micro>(end - start).count()});
+            }
+            if (!keepGoing) break;
+        }
+    }
+
+    // Removes the session_<n>/ directories a previous run left in the
+    // current directory, so every run starts from the same empty state.
+    // Nothing else in the replay directory is touched.
+    static bool clearPreviousRun() {
+        DIR* dir = opendir(".");
+        if (!dir) return false;
+
+        vector<string> sessionDirs;
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            string name = entry->d_name;
+            if (name.compare(0, 8, "session_") == 0 && name.size() > 8 &&
+                name.find_first_not_of("0123456789", 8) == string::npos) {
+                sessionDirs.push_back(name);
+            }
+        }
+        closedir(dir);
+
+        bool ok = true;
+        for (const auto& name : sessionDirs) {
+            DIR* session = opendir(name.c_str());
+            if (!session) continue;
+            while ((entry = readdir(session)) != nullptr) {
+                string file = entry->d_name;
+                if (file != "." && file != "..") unlink((name + "/" + file).c_str());
+            }
+            closedir(session);
+            ok = rmdir(name.c_str()) == 0 && ok;
+        }
+        return ok;
+    }
+
+    static double percentile(const vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0;
+        size_t index = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[min(index, sorted.size() - 1)];
+    }
+
+    static void printRow(const string& name, vector<double>& values) {
+        sort(values.begin(), values.end());
+        cout << "  " << left << setw(16) << name << right << setw(8) << values.size()
+             << setw(11) << percentile(values, 50) << setw(11) << percentile(values, 90)
+             << setw(11) << percentile(values, 99) << setw(11) << values.back() << "\n";
+    }
+
+public:
+    SessionReplayer(double replaySpeed, int sessionCopies)
+        : speed(replaySpeed), copies(max(1, sessionCopies)) {}
+
+    bool addRecording(const string& path) {
+        vector<RecordedLine> lines;
+        if (!SessionRecorder::load(path, lines)) return false;
+        recordings.push_back(lines);
+        return true;
+    }
+
+    // Conversations are written under workDir so replays never touch the
+    // user's own conversations/ directory. Each session gets its own
+    // session_<n>/ there, so copies of a recording never share files, and
+    // those left by the previous run are removed first.
+    int run(const string& workDir) {
+        if (recordings.empty()) {
+            cerr << "Error: No recordings to replay\n";
+            return 1;
+        }
+
+        mkdir(workDir.c_str(), 0755);
+        if (chdir(workDir.c_str()) != 0) {
+            cerr << "Error: Could not enter replay directory " << workDir << "\n";
+            return 1;
+        }
+        if (!clearPreviousRun()) {
+            cerr << "Error: Could not clear the previous run in " << workDir << "\n";
+            return 1;
+        }
+
+        size_t sessions = recordings.size() * copies;
+        vector<vector<Sample>> samples(sessions);
+        vector<thread> threads;
+
+        NullBuffer discard;
+        streambuf* console = cout.rdbuf(&discard);
+        auto start = chrono::steady_clock::now();
+
+        for (size_t i = 0; i < sessions; i++) {
+            threads.emplace_back(runSession, &recordings[i % recordings.size()], speed,
+                                 "session_" + to_string(i + 1) + "/", &samples[i]);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout.rdbuf(console);
+
+        map<string, vector<double>> byCommand;
+        vector<double> all;
+        for (const auto& session : samples) {
+            for (const auto& sample : session) {
+                byCommand[sample.command].push_back(sample.micros);
+                all.push_back(sample.micros);
+            }
+        }
+
+        cout << "\n=== Replay Report ===\n" << fixed << setprecision(1);
+        cout << "  sessions:   " << sessions << "\n";
+        cout << "  commands:   " << all.size() << "\n";
+        cout << "  wall time:  " << seconds << " s\n";
+        cout << "  throughput: " << (seconds > 0 ? all.size() / seconds : 0) << " commands/s\n\n";
+
+        if (!all.empty()) {
+            cout << "  " << left << setw(16) << "command" << right << setw(8) << "count"
+                 << setw(11) << "p50 us" << setw(11) << "p90 us" << setw(11) << "p99 us"
+                 << setw(11) << "max us" << "\n";
+            for (auto& entry : byCommand) {
+                printRow(entry.first, entry.second);
+            }
+            printRow("all", all);
+        }
+        return 0;
+    }
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef SPILL_SEGMENT_H
+#define SPILL_SEGMENT_H
+
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <mutex>
+#include <condition_variable>
+#include "message.hpp"
+
+using namespace std;
+
+struct SpilledMessage {
+    string type;
+    string timestamp;
+    uint64_t offset;
+    uint32_t length;
+};
+
+// Append-only scratch file holding the content of messages evicted from
+// memory. The owner reserves byte ranges without touching the disk; the
+// persistence writer thread creates the file on first use and writes each
+// range in reservation order. The file is unlinked right after creation, so
+// it disappears with the process. Reads use pread and wait until their
+// range has been written, so they are safe from any thread.
+class SpillSegment {
+private:
+    int fd;
+    uint64_t reserved;
+    uint64_t written;
+    bool failed;
+    mutable mutex writeMutex;
+    mutable condition_variable writeDone;
+
+    bool create() {
+        char path[] = "/tmp/chatbot_spill_XXXXXX";
+        fd = mkstemp(path);
+        if (fd < 0) return false;
+        unlink(path);
+        return true;
+    }
+
+public:
+    SpillSegment() : fd(-1), reserved(0), written(0), failed(false) {}
+
+    ~SpillSegment() {
+        if (fd >= 0) close(fd);
+    }
+
+    SpillSegment(const SpillSegment&) = delete;
+    SpillSegment& operator=(const SpillSegment&) = delete;
+
+    // Owner only: claims the next length bytes for a later writeAt().
+    uint64_t reserve(size_t length) {
+        uint64_t offset = reserved;
+        reserved += length;
+        return offset;
+    }
+
+    // Writer thread only, in reservation order.
+    bool writeAt(const string& data, uint64_t offset) {
+        bool ok = !failed && (fd >= 0 || create());
+
+        size_t done = 0;
+        while (ok && done < data.size()) {
+            ssize_t n = pwrite(fd, data.data() + done, data.size() - done, offset + done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) ok = false;
+            else done += n;
+        }
+
+        lock_guard<mutex> lock(writeMutex);
+        if (ok) written = offset + data.size();
+        else failed = true;
+        writeDone.notify_all();
+        return ok;
+    }
+
+    bool read(uint64_t offset, uint32_t length, string& out) const {
+        {
+            unique_lock<mutex> lock(writeMutex);
+            writeDone.wait(lock, [&] { return failed || written >= offset + length; });
+            if (written < offset + length) return false;
+        }
+
+        out.assign(length, '\0');
+        size_t done = 0;
+        while (done < length) {
+            ssize_t n = pread(fd, &out[done], length - done, offset + done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            done += n;
+        }
+        return true;
+    }
+
+    bool load(const SpilledMessage& entry, Message& msg) const {
+        msg.type = entry.type;
+        msg.timestamp = entry.timestamp;
+        return read(entry.offset, entry.length, msg.content);
+    }
+
+    uint64_t bytes() const {
+        return reserved;
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <ctime>
+
+using namespace std;
+
+// Measures time from the first exec to the first prompt. The clock is
+// CLOCK_REALTIME so the measurement survives the re-exec inside tmux: the
+// parent forwards its origin, last mark and finished phases as arguments.
+class StartupProfiler {
+private:
+    bool enabled;
+    bool reported;
+    int64_t originNs;
+    int64_t lastNs;
+    vector<pair<string, int64_t>> phases;
+
+    static int64_t parseInt(const string& value) {
+        return strtoll(value.c_str(), nullptr, 10);
+    }
+
+    // Format: name=ns,name=ns,...
+    void parsePhases(const string& encoded) {
+        size_t start = 0;
+        while (start < encoded.size()) {
+            size_t end = encoded.find(',', start);
+            if (end == string::npos) end = encoded.size();
+
+            string item = encoded.substr(start, end - start);
+            size_t eq = item.find('=');
+            if (eq != string::npos) {
+                phases.push_back(make_pair(item.substr(0, eq), parseInt(item.substr(eq + 1))));
+            }
+            start = end + 1;
+        }
+    }
+
+public:
+    StartupProfiler(int argc, char* argv[])
+        : enabled(false), reported(false), originNs(nowNs()), lastNs(originNs) {
+        bool inherited = false;
+
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--startup-profile") {
+                enabled = true;
+            } else if (arg.find("--startup-origin=") == 0) {
+                originNs = parseInt(arg.substr(17));
+                inherited = true;
+            } else if (arg.find("--startup-last=") == 0) {
+                lastNs = parseInt(arg.substr(15));
+            } else if (arg.find("--startup-phases=") == 0) {
+                parsePhases(arg.substr(17));
+            }
+        }
+
+        if (enabled && inherited) {
+            mark("tmux-launch");
+        }
+    }
+
+    static int64_t nowNs() {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+
+    static bool isProfileArg(const string& arg) {
+        return arg.find("--startup-") == 0;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    void mark(const string& phase) {
+        if (!enabled) return;
+
+        int64_t now = nowNs();
+        phases.push_back(make_pair(phase, now - lastNs));
+        lastNs = now;
+    }
+
+    // Arguments that carry the measurement into a re-exec'd child.
+    vector<string> forwardArgs() const {
+        vector<string> args;
+        if (!enabled) return args;
+
+        string encoded;
+        for (const auto& phase : phases) {
+            if (!encoded.empty()) encoded += ',';
+            encoded += phase.first + "=" + to_string(phase.second);
+        }
+
+        args.push_back("--startup-profile");
+        args.push_back("--startup-origin=" + to_string(originNs));
+        args.push_back("--startup-last=" + to_string(nowNs()));
+        if (!encoded.empty()) args.push_back("--startup-phases=" + encoded);
+        return args;
+    }
+
+    void report() {
+        if (!enabled || reported) return;
+        reported = true;
+
+        mark("first-prompt");
+
+        cout << "\n=== Startup Profile ===\n" << fixed << setprecision(3);
+        for (const auto& phase : phases) {
+            cout << "  " << left << setw(22) << phase.first << right << setw(10)
+                 << phase.second / 1e6 << " ms\n";
+        }
+        cout << "  " << left << setw(22) << "total (exec to prompt)" << right << setw(10)
+             << (lastNs - originNs) / 1e6 << " ms\n";
+        cout.unsetf(ios::floatfield | ios::adjustfield);
+        cout.precision(6);
+    }
+};
+
+#endif
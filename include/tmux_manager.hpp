@@ -4,18 +4,27 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <cstring>
 #include <fcntl.h>
+#include <cerrno>
+#include "startup_profiler.hpp"
+#include "answer_pager.hpp"
 
 using namespace std;
 
 class TmuxManager {
 private:
     bool answerPanelOpen;
+    bool headless;
     string sessionName;
+    string answerPane;
+    string answerTty;
+    AnswerPager pager;
 
     int executeTmuxCommand(const char* arg1, const char* arg2 = nullptr, 
                           const char* arg3 = nullptr, const char* arg4 = nullptr) {
@@ -28,13 +37,13 @@ private:
         
         if (pid == 0) {
             if (arg4) {
-                execl("/usr/bin/tmux", "tmux", arg1, arg2, arg3, arg4, (char*)NULL);
+                execlp("tmux", "tmux", arg1, arg2, arg3, arg4, (char*)NULL);
             } else if (arg3) {
-                execl("/usr/bin/tmux", "tmux", arg1, arg2, arg3, (char*)NULL);
+                execlp("tmux", "tmux", arg1, arg2, arg3, (char*)NULL);
             } else if (arg2) {
-                execl("/usr/bin/tmux", "tmux", arg1, arg2, (char*)NULL);
+                execlp("tmux", "tmux", arg1, arg2, (char*)NULL);
             } else {
-                execl("/usr/bin/tmux", "tmux", arg1, (char*)NULL);
+                execlp("tmux", "tmux", arg1, (char*)NULL);
             }
             exit(1);
         }
@@ -45,17 +54,19 @@ private:
     }
 
 public:
-    TmuxManager() : answerPanelOpen(false), sessionName("chatbot_session") {}
+    // A headless manager never touches tmux; used when replaying sessions.
+    explicit TmuxManager(bool noPanels = false)
+        : answerPanelOpen(false), headless(noPanels), sessionName("chatbot_session") {}
 
     bool isInTmux() {
         return getenv("TMUX") != nullptr;
     }
 
-    void killExistingSession() {
+    bool sessionExists() {
         pid_t pid = fork();
         
         if (pid < 0) {
-            return;
+            return false;
         }
         
         if (pid == 0) {
@@ -63,86 +74,271 @@ public:
             dup2(devnull, STDERR_FILENO);
             close(devnull);
             
-            execl("/usr/bin/tmux", "tmux", "has-session", "-t", 
+            execlp("tmux", "tmux", "has-session", "-t", 
                   sessionName.c_str(), (char*)NULL);
             exit(1);
         }
         
         int status;
         waitpid(pid, &status, 0);
-        
-        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
-            executeTmuxCommand("kill-session", "-t", sessionName.c_str());
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    static int runTmux(const vector<string>& args) {
+        vector<char*> argv;
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            return -1;
+        }
+        if (pid == 0) {
+            execvp("tmux", argv.data());
+            exit(1);
         }
+
+        int status;
+        waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
     }
 
-    void ensureTmuxSession() {
-        if (!isInTmux()) {
-            killExistingSession();
-            
-            char exePath[1024];
-            ssize_t len = readlink("/proc/self/exe", exePath, sizeof(exePath)-1);
-            if (len != -1) {
-                exePath[len] = '\0';
-            } else {
-                strcpy(exePath, "./bin/chatbot");
+    // Runs tmux and collects its stdout; false if it did not exit cleanly.
+    static bool captureTmux(const vector<string>& args, string& out) {
+        vector<char*> argv;
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if (pid == 0) {
+            dup2(fds[1], STDOUT_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            int devnull = open("/dev/null", O_WRONLY);
+            dup2(devnull, STDERR_FILENO);
+            close(devnull);
+            execvp("tmux", argv.data());
+            exit(1);
+        }
+
+        close(fds[1]);
+        out.clear();
+        char buf[256];
+        ssize_t n;
+        while ((n = read(fds[0], buf, sizeof(buf))) != 0) {
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
             }
-            
-            string cmd = "tmux new-session -s " + sessionName + " \"" + 
-                            string(exePath) + " && exec $SHELL\"";
-            system(cmd.c_str());
-            exit(0);
+            out.append(buf, n);
+        }
+        close(fds[0]);
+
+        int status;
+        waitpid(pid, &status, 0);
+        while (!out.empty() && out.back() == '\n') out.pop_back();
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    static void execTmux(const vector<string>& args) {
+        vector<char*> argv;
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
         }
+        argv.push_back(nullptr);
+
+        execvp("tmux", argv.data());
+        perror("Failed to start tmux");
+        exit(1);
+    }
+
+    // Re-runs this binary inside tmux and never returns when outside it.
+    // A live session is reused by opening a new window in it and attaching,
+    // instead of killing it. The chatbot is exec'd by tmux directly, with no
+    // intermediate shell, and the current process is replaced by tmux.
+    void ensureTmuxSession(StartupProfiler& profiler, const vector<string>& childArgs) {
+        if (isInTmux()) {
+            return;
+        }
+        
+        char exePath[1024];
+        ssize_t len = readlink("/proc/self/exe", exePath, sizeof(exePath)-1);
+        if (len != -1) {
+            exePath[len] = '\0';
+        } else {
+            strcpy(exePath, "./bin/chatbot");
+        }
+        
+        char cwd[4096];
+        if (!getcwd(cwd, sizeof(cwd))) {
+            strcpy(cwd, ".");
+        }
+        
+        bool reuse = sessionExists();
+        profiler.mark("tmux-has-session");
+        
+        vector<string> command;
+        command.push_back(exePath);
+        command.insert(command.end(), childArgs.begin(), childArgs.end());
+        vector<string> profileArgs = profiler.forwardArgs();
+        
+        vector<string> args;
+        args.push_back("tmux");
+        if (reuse) {
+            args.push_back("new-window");
+            args.push_back("-t");
+            args.push_back(sessionName + ":");
+            args.push_back("-c");
+            args.push_back(cwd);
+            args.insert(args.end(), command.begin(), command.end());
+            args.insert(args.end(), profileArgs.begin(), profileArgs.end());
+            if (runTmux(args) != 0) {
+                cerr << "Failed to open a window in tmux session " << sessionName << "\n";
+                exit(1);
+            }
+            execTmux({"tmux", "attach-session", "-t", sessionName});
+        }
+        
+        args.push_back("new-session");
+        args.push_back("-s");
+        args.push_back(sessionName);
+        args.push_back("-c");
+        args.push_back(cwd);
+        args.insert(args.end(), command.begin(), command.end());
+        args.insert(args.end(), profileArgs.begin(), profileArgs.end());
+        execTmux(args);
     }
 
     bool paneExists() {
-        return system("tmux list-panes | grep -q '^1:'") == 0;
+        if (headless || answerPane.empty()) return false;
+        string id;
+        return captureTmux({"tmux", "display-message", "-p", "-t", answerPane, "#{pane_id}"}, id);
     }
 
-    void killSession() {
-        executeTmuxCommand("kill-session", "-t", sessionName.c_str());
+    // Closes only this chatbot's window (and its answer pane), leaving any
+    // other windows of a reused session alive. The session ends with its
+    // last window. A window in any other session belongs to the user, who
+    // started the chatbot from their own tmux, so only the answer pane goes.
+    void closeWindow() {
+        if (headless) return;
+        
+        closeAnswerPanel();
+        
+        const char* pane = getenv("TMUX_PANE");
+        string owner;
+        if (pane && captureTmux({"tmux", "display-message", "-p", "-t", pane, "#{session_name}"}, owner) &&
+            owner == sessionName) {
+            executeTmuxCommand("kill-window", "-t", pane);
+        }
     }
 
+    // The pane only holds a silent placeholder process; pages are written
+    // straight to its tty, so each render sends one screen and nothing else.
     void openAnswerPanel(const string& answer) {
-        if (!paneExists()) {
+        if (headless) return;
+        
+        pager.setText(answer);
+        
+        if (!answerPanelOpen || !paneExists()) {
+            string created;
+            bool ok = captureTmux({"tmux", "split-window", "-d", "-h", "-P", "-F",
+                                   "#{pane_id} #{pane_tty}",
+                                   "stty -echo -icanon; exec cat > /dev/null"}, created);
+            size_t space = created.find(' ');
+            if (!ok || space == string::npos) {
+                cerr << "Could not open answer panel\n";
+                answerPanelOpen = false;
+                return;
+            }
+            answerPane = created.substr(0, space);
+            answerTty = created.substr(space + 1);
+            answerPanelOpen = true;
+        }
+        
+        renderPage();
+    }
+
+    // Re-reads the pane size on every render, so a resized pane reflows
+    // around the first row of the current page.
+    bool renderPage() {
+        if (headless || !answerPanelOpen) return false;
+        
+        string geometry;
+        if (!captureTmux({"tmux", "display-message", "-p", "-t", answerPane,
+                          "#{pane_width} #{pane_height}"}, geometry)) {
             answerPanelOpen = false;
+            return false;
         }
         
-        if (answerPanelOpen) {
-            updateAnswerPanel(answer);
-            return;
+        size_t columns = 0, rows = 0;
+        if (sscanf(geometry.c_str(), "%zu %zu", &columns, &rows) == 2) {
+            pager.setGeometry(columns, rows);
+        }
+        
+        string frame = pager.render();
+        int fd = open(answerTty.c_str(), O_WRONLY | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0) {
+            answerPanelOpen = false;
+            return false;
         }
+        
+        size_t done = 0;
+        while (done < frame.size()) {
+            ssize_t n = write(fd, frame.data() + done, frame.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            done += n;
+        }
+        close(fd);
+        return done == frame.size();
+    }
 
-        string tempFile = "/tmp/chatbot_answer.txt";
-        ofstream file(tempFile);
-        file << answer;
-        file.close();
+    // Page numbers are 1-based for the user.
+    bool showPage(size_t number) {
+        if (!answerPanelOpen || number < 1 || !pager.seek(number - 1)) return false;
+        return renderPage();
+    }
 
-        string cmd = "tmux split-window -h 'cat " + tempFile + 
-                         " && echo \"\" && echo \"Press Enter to continue...\" && read'";
-        system(cmd.c_str());
-        
-        answerPanelOpen = true;
+    bool nextPage() {
+        return showPage(pager.currentPage() + 2);
     }
 
-    void updateAnswerPanel(const string& answer) {
-        string tempFile = "/tmp/chatbot_answer.txt";
-        ofstream file(tempFile);
-        file << answer;
-        file.close();
+    bool prevPage() {
+        return pager.currentPage() > 0 && showPage(pager.currentPage());
+    }
+
+    size_t currentPage() const {
+        return pager.currentPage() + 1;
+    }
 
-        system("tmux send-keys -t 1 C-c");
-        string cmd = "tmux send-keys -t 1 'cat " + tempFile + 
-                         " && echo \"\" && echo \"Press Enter to continue...\" && read' Enter";
-        system(cmd.c_str());
+    size_t pageCount() const {
+        return pager.pageCount();
     }
 
     void closeAnswerPanel() {
+        if (headless) return;
+        
         if (paneExists()) {
-            executeTmuxCommand("kill-pane", "-t", "1");
+            executeTmuxCommand("kill-pane", "-t", answerPane.c_str());
             cout << "Answer panel closed.\n";
         }
         answerPanelOpen = false;
+        answerPane.clear();
+        answerTty.clear();
     }
 
     bool isPanelOpen() const {
@@ -0,0 +1,146 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+// Fixed set of workers, each with its own deque. A worker pops its newest
+// task first (tasks it just spawned, still warm in cache) and, when empty,
+// steals the oldest task from another worker. Tasks may submit more tasks;
+// wait() returns once every submitted task, including spawned ones, ran.
+class WorkStealingPool {
+private:
+    struct Queue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    atomic<size_t> queued;
+    atomic<size_t> pending;
+    atomic<size_t> nextQueue;
+    bool stopping;
+
+    mutex idleMutex;
+    condition_variable workAvailable;
+    condition_variable allDone;
+
+    struct WorkerSlot {
+        const WorkStealingPool* pool;
+        int index;
+    };
+
+    static WorkerSlot& currentWorker() {
+        static thread_local WorkerSlot slot = {nullptr, -1};
+        return slot;
+    }
+
+    bool popLocal(size_t index, function<void()>& task) {
+        Queue& queue = *queues[index];
+        lock_guard<mutex> lock(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, function<void()>& task) {
+        for (size_t i = 1; i < queues.size(); i++) {
+            Queue& victim = *queues[(thief + i) % queues.size()];
+            unique_lock<mutex> lock(victim.lock, try_to_lock);
+            if (!lock.owns_lock() || victim.tasks.empty()) continue;
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(size_t index) {
+        currentWorker() = {this, (int)index};
+
+        function<void()> task;
+        while (true) {
+            if (popLocal(index, task) || steal(index, task)) {
+                queued--;
+                task();
+                task = nullptr;
+                if (--pending == 0) {
+                    lock_guard<mutex> lock(idleMutex);
+                    allDone.notify_all();
+                }
+                continue;
+            }
+
+            unique_lock<mutex> lock(idleMutex);
+            workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned threads = 0)
+        : queued(0), pending(0), nextQueue(0), stopping(false) {
+        if (threads == 0) {
+            threads = max(8u, 2 * thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            queues.emplace_back(new Queue());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back(&WorkStealingPool::run, this, i);
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(idleMutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    // From a worker the task lands on that worker's own deque; from any
+    // other thread the deques are filled round-robin.
+    void submit(function<void()> task) {
+        WorkerSlot& slot = currentWorker();
+        size_t index = slot.pool == this ? (size_t)slot.index : nextQueue++ % queues.size();
+
+        pending++;
+        queued++;
+        {
+            lock_guard<mutex> lock(queues[index]->lock);
+            queues[index]->tasks.push_back(move(task));
+        }
+
+        lock_guard<mutex> lock(idleMutex);
+        workAvailable.notify_one();
+    }
+
+    void wait() {
+        unique_lock<mutex> lock(idleMutex);
+        allDone.wait(lock, [this] { return pending == 0; });
+    }
+};
+
+#endif
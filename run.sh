@@ -4,6 +4,7 @@ PROJECT_NAME=chatbot
 COMPILER=g++
 INCLUDE=include
 MAIN_FILE=main.cpp
+ADMIN_FILE=admin.cpp
 
 # detect package manager
 PACKAGE_MANAGER=""
@@ -83,8 +84,26 @@ if ! command -v tmux &> /dev/null; then
     echo "tmux installed successfully!"
 fi
 
+# check if zlib headers are installed (used for binary conversation files)
+if [ ! -f /usr/include/zlib.h ]; then
+    echo "zlib development headers not found."
+
+    case $PACKAGE_MANAGER in
+        apt-get)
+            install_package "zlib1g-dev"
+            ;;
+        dnf|yum|zypper)
+            install_package "zlib-devel"
+            ;;
+        pacman)
+            install_package "zlib"
+            ;;
+    esac
+fi
+
 sleep 1
 clear
 
-$COMPILER -I./$INCLUDE $MAIN_FILE -o bin/$PROJECT_NAME
+$COMPILER -std=c++17 -I./$INCLUDE $MAIN_FILE -o bin/$PROJECT_NAME -lz
+$COMPILER -std=c++17 -O2 -I./$INCLUDE $ADMIN_FILE -o bin/$PROJECT_NAME-admin -lz
 ./bin/$PROJECT_NAME
\ No newline at end of file